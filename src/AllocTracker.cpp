@@ -0,0 +1,124 @@
+#include "AllocTracker.h"
+
+#include <cstdio>
+
+AllocTracker::Counters
+    AllocTracker::counters[static_cast<int>(AllocCategory::Count)];
+std::atomic<std::uint64_t> AllocTracker::frameAllocations{0};
+std::atomic<std::uint64_t> AllocTracker::lastFrameAllocations{0};
+std::atomic<std::int64_t> AllocTracker::totalLiveBytes{0};
+std::atomic<std::int64_t> AllocTracker::totalPeakBytes{0};
+
+namespace {
+void updatePeak(std::atomic<std::int64_t>& peak, std::int64_t value) {
+  std::int64_t previous = peak.load(std::memory_order_relaxed);
+  while (value > previous &&
+         !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
+void AllocTracker::recordAlloc(AllocCategory category, std::size_t bytes) {
+  Counters& c = counters[static_cast<int>(category)];
+  std::int64_t size = static_cast<std::int64_t>(bytes);
+
+  c.liveCount.fetch_add(1, std::memory_order_relaxed);
+  c.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+  updatePeak(c.peakBytes, c.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+  updatePeak(totalPeakBytes,
+             totalLiveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+  frameAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocTracker::recordFree(AllocCategory category, std::size_t bytes) {
+  Counters& c = counters[static_cast<int>(category)];
+  std::int64_t size = static_cast<std::int64_t>(bytes);
+
+  c.liveCount.fetch_sub(1, std::memory_order_relaxed);
+  c.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+  totalLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void AllocTracker::beginFrame() {
+  lastFrameAllocations.store(frameAllocations.exchange(0, std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+}
+
+std::int64_t AllocTracker::getLiveCount(AllocCategory category) {
+  return counters[static_cast<int>(category)].liveCount.load(std::memory_order_relaxed);
+}
+
+std::int64_t AllocTracker::getLiveBytes(AllocCategory category) {
+  return counters[static_cast<int>(category)].liveBytes.load(std::memory_order_relaxed);
+}
+
+std::int64_t AllocTracker::getTotalLiveCount() {
+  std::int64_t total = 0;
+  for (int i = 0; i < static_cast<int>(AllocCategory::Count); i++) {
+    total += getLiveCount(static_cast<AllocCategory>(i));
+  }
+  return total;
+}
+
+std::int64_t AllocTracker::getTotalLiveBytes() {
+  return totalLiveBytes.load(std::memory_order_relaxed);
+}
+
+std::int64_t AllocTracker::getTotalPeakBytes() {
+  return totalPeakBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocTracker::getLastFrameAllocations() {
+  return lastFrameAllocations.load(std::memory_order_relaxed);
+}
+
+const char* AllocTracker::categoryName(AllocCategory category) {
+  switch (category) {
+    case AllocCategory::Player:
+      return "Player";
+    case AllocCategory::Enemy:
+      return "Enemy";
+    case AllocCategory::Projectile:
+      return "Projectile";
+    case AllocCategory::Window:
+      return "Window";
+    default:
+      return "Unknown";
+  }
+}
+
+std::string AllocTracker::describe() {
+  char buffer[128];
+  std::string result;
+  for (int i = 0; i < static_cast<int>(AllocCategory::Count); i++) {
+    AllocCategory category = static_cast<AllocCategory>(i);
+    std::snprintf(buffer, sizeof(buffer), "%s %lld (%lld B)  ",
+                  categoryName(category),
+                  static_cast<long long>(getLiveCount(category)),
+                  static_cast<long long>(getLiveBytes(category)));
+    result += buffer;
+  }
+  std::snprintf(buffer, sizeof(buffer),
+                "\nLive %lld B  Peak %lld B  Allocs/frame %llu",
+                static_cast<long long>(getTotalLiveBytes()),
+                static_cast<long long>(getTotalPeakBytes()),
+                static_cast<unsigned long long>(getLastFrameAllocations()));
+  result += buffer;
+  return result;
+}
+
+void AllocTracker::dump(std::ostream& out) {
+  out << "[alloc] category      live      bytes       peak      total\n";
+  for (int i = 0; i < static_cast<int>(AllocCategory::Count); i++) {
+    const Counters& c = counters[i];
+    char line[128];
+    std::snprintf(line, sizeof(line), "[alloc] %-10s %8lld %10lld %10lld %10llu\n",
+                  categoryName(static_cast<AllocCategory>(i)),
+                  static_cast<long long>(c.liveCount.load()),
+                  static_cast<long long>(c.liveBytes.load()),
+                  static_cast<long long>(c.peakBytes.load()),
+                  static_cast<unsigned long long>(c.totalAllocations.load()));
+    out << line;
+  }
+  out << "[alloc] peak total bytes " << getTotalPeakBytes() << std::endl;
+}
@@ -0,0 +1,64 @@
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <string>
+
+enum class AllocCategory {
+  Player,
+  Enemy,
+  Projectile,
+  Window,
+  Count
+};
+
+// Per-category live object/byte accounting for heap-allocated game objects.
+class AllocTracker {
+ private:
+  struct Counters {
+    std::atomic<std::int64_t> liveCount{0};
+    std::atomic<std::int64_t> liveBytes{0};
+    std::atomic<std::int64_t> peakBytes{0};
+    std::atomic<std::uint64_t> totalAllocations{0};
+  };
+
+  static Counters counters[static_cast<int>(AllocCategory::Count)];
+  static std::atomic<std::uint64_t> frameAllocations;
+  static std::atomic<std::uint64_t> lastFrameAllocations;
+  static std::atomic<std::int64_t> totalLiveBytes;
+  static std::atomic<std::int64_t> totalPeakBytes;
+
+ public:
+  static void recordAlloc(AllocCategory category, std::size_t bytes);
+  static void recordFree(AllocCategory category, std::size_t bytes);
+  static void beginFrame();
+
+  static std::int64_t getLiveCount(AllocCategory category);
+  static std::int64_t getLiveBytes(AllocCategory category);
+  static std::int64_t getTotalLiveCount();
+  static std::int64_t getTotalLiveBytes();
+  static std::int64_t getTotalPeakBytes();
+  static std::uint64_t getLastFrameAllocations();
+
+  static const char* categoryName(AllocCategory category);
+  static std::string describe();
+  static void dump(std::ostream& out);
+};
+
+// Base class that routes `new`/`delete` of a class through AllocTracker.
+template <AllocCategory Category>
+struct TrackedAllocation {
+  static void* operator new(std::size_t size) {
+    AllocTracker::recordAlloc(Category, size);
+    return ::operator new(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    AllocTracker::recordFree(Category, size);
+    ::operator delete(ptr);
+  }
+};
+
+#endif  // ALLOCTRACKER_H
@@ -0,0 +1,194 @@
+#include "Benchmarks.h"
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "BulletPattern.h"
+#include "BulletPool.h"
+#include "CollisionSystem.h"
+#include "GpuTimer.h"
+#include "RenderList.h"
+#include "ThreadPool.h"
+
+namespace {
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+bool sameHits(const std::vector<HitEvent>& a, const std::vector<HitEvent>& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].source != b[i].source || a[i].target != b[i].target) return false;
+  }
+  return true;
+}
+}  // namespace
+
+int runCollisionBenchmark() {
+  const size_t projectileCounts[] = {10000, 100000};
+  const size_t enemyCount = 500;
+  const int iterations = 10;
+  const float worldSize = 4000.0f;
+
+  size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<size_t> threadCounts;
+  for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+
+  std::mt19937 randomEngine(1234);
+  std::uniform_real_distribution<float> posDist(0.0f, worldSize);
+  std::vector<sf::FloatRect> enemies;
+  for (size_t i = 0; i < enemyCount; i++) {
+    enemies.push_back({{posDist(randomEngine), posDist(randomEngine)}, {26.0f, 26.0f}});
+  }
+
+  int result = 0;
+  std::printf("[bench] collisions: %zu enemies, %d iterations, up to %zu threads\n",
+              enemyCount, iterations, maxThreads);
+
+  for (size_t projectileCount : projectileCounts) {
+    std::vector<sf::FloatRect> shots;
+    for (size_t i = 0; i < projectileCount; i++) {
+      shots.push_back({{posDist(randomEngine), posDist(randomEngine)}, {4.0f, 4.0f}});
+    }
+
+    std::vector<HitEvent> reference;
+    double baselineMs = 0.0;
+
+    for (size_t threads : threadCounts) {
+      ThreadPool pool(threads - 1);
+      CollisionSystem collisions(&pool);
+      std::vector<HitEvent> hits;
+
+      // Warm-up pass also provides the result to compare against.
+      collisions.detectShots(shots, enemies, hits);
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; i++) {
+        hits.clear();
+        collisions.detectShots(shots, enemies, hits);
+      }
+      double ms = elapsedMs(start) / iterations;
+
+      if (threads == 1) {
+        reference = hits;
+        baselineMs = ms;
+      } else if (!sameHits(reference, hits)) {
+        std::printf("[bench] MISMATCH at %zu threads\n", threads);
+        result = 1;
+      }
+
+      std::printf("[bench] %7zu projectiles %2zu threads: %8.3f ms/frame  "
+                  "speedup %.2fx  hits %zu\n",
+                  projectileCount, threads, ms, baselineMs / ms, hits.size());
+    }
+  }
+  return result;
+}
+
+int runBulletBenchmark() {
+  const size_t emitterCount = 250;
+  const int warmupFrames = 120;
+  const int measuredFrames = 600;
+  const float dt = 1.0f / 60.0f;
+  const float worldSize = 4000.0f;
+  const double budgetMs = 1000.0 / 60.0;
+
+  // 250 emitters x 40 bullets every 0.2 s, living 1 s: ~50k bullets live.
+  std::istringstream definition(
+      "ring bench count=40 cooldown=0.2 speed=300 spin=4.5 lifetime=1.0 radius=1.5\n");
+  BulletPatternLibrary library = BulletPatternLibrary::parse(definition, "bench");
+
+  BulletPool pool;
+  std::mt19937 randomEngine(1234);
+  std::uniform_real_distribution<float> posDist(0.0f, worldSize);
+  std::uniform_real_distribution<float> phaseDist(0.0f, 0.2f);
+  std::vector<BulletEmitter> emitters;
+  std::vector<sf::Vector2f> origins;
+  for (size_t i = 0; i < emitterCount; i++) {
+    emitters.emplace_back(&library.get(0));
+    origins.push_back({posDist(randomEngine), posDist(randomEngine)});
+    // Stagger the first volleys so spawning is spread across frames.
+    emitters.back().update(phaseDist(randomEngine), origins.back(), {}, false, pool);
+  }
+
+  sf::FloatRect bounds({-500.0f, -500.0f}, {worldSize + 1000.0f, worldSize + 1000.0f});
+  sf::Vector2f playerPos(worldSize / 2.0f, worldSize / 2.0f);
+  sf::FloatRect playerHitbox(playerPos - sf::Vector2f(4.0f, 4.0f), {8.0f, 8.0f});
+  std::vector<std::uint32_t> hits;
+  RenderList list;
+
+  // Draw every frame off-screen and wait for the GPU, so the budget covers
+  // rendering too. Without a GL context only simulation and vertex building
+  // are measured.
+  sf::RenderTexture target;
+  bool rendered = target.resize({1920, 1080});
+  if (!rendered) {
+    std::printf("[bench] no render target available, measuring without drawing\n");
+  }
+  sf::View view(bounds.getCenter(), bounds.size);
+
+  std::vector<double> frameMs;
+  size_t liveTotal = 0;
+  size_t hitTotal = 0;
+  for (int frame = 0; frame < warmupFrames + measuredFrames; frame++) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < emitterCount; i++) {
+      emitters[i].update(dt, origins[i], playerPos, true, pool);
+    }
+    pool.update(dt, bounds);
+    hits.clear();
+    pool.detectHits(playerHitbox, hits);
+    for (std::uint32_t index : hits) {
+      pool.kill(index);
+    }
+    list.clear();
+    list.setView(view);
+    pool.addToRenderList(bounds, list);
+    if (rendered) {
+      target.clear();
+      list.draw(target);
+      target.display();
+      (void)target.setActive(true);
+      GpuTimer::finish();
+    }
+
+    if (frame >= warmupFrames) {
+      frameMs.push_back(elapsedMs(start));
+      liveTotal += pool.size();
+      hitTotal += hits.size();
+    }
+  }
+
+  std::sort(frameMs.begin(), frameMs.end());
+  double mean = 0.0;
+  for (double ms : frameMs) {
+    mean += ms;
+  }
+  mean /= frameMs.size();
+  double p99 = frameMs[frameMs.size() * 99 / 100];
+  size_t averageLive = liveTotal / frameMs.size();
+
+  std::printf("[bench] bullets: %zu emitters, %zu live on average (capacity %zu), %s\n",
+              emitterCount, averageLive, pool.getCapacity(),
+              rendered ? "drawn at 1920x1080" : "not drawn");
+  std::printf("[bench] per frame: mean %.3f ms  p99 %.3f ms  max %.3f ms  "
+              "player hits %zu\n",
+              mean, p99, frameMs.back(), hitTotal);
+
+  bool pass = p99 < budgetMs;
+  std::printf("[bench] %s: p99 %s the %.1f ms frame budget\n", pass ? "PASS" : "FAIL",
+              pass ? "within" : "exceeds", budgetMs);
+  return pass ? 0 : 1;
+}
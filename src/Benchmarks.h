@@ -0,0 +1,12 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+// Headless micro-benchmarks selectable from the command line. Each returns a
+// process exit code (non-zero when results disagree between configurations).
+int runCollisionBenchmark();
+// Steady state of ~50k enemy bullets: emit, move, collide, record them into a
+// RenderList the way the game does and draw it off-screen, on one thread.
+// Fails when the 99th percentile frame misses 60 FPS.
+int runBulletBenchmark();
+
+#endif  // BENCHMARKS_H
@@ -0,0 +1,237 @@
+#include "BulletPattern.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "BulletPool.h"
+
+namespace {
+const float DEG_TO_RAD = 3.14159265f / 180.0f;
+
+bool parseKind(const std::string& name, PatternKind& kind) {
+  if (name == "ring") {
+    kind = PatternKind::Ring;
+  } else if (name == "spiral") {
+    kind = PatternKind::Spiral;
+  } else if (name == "aimed") {
+    kind = PatternKind::AimedBurst;
+  } else if (name == "wave") {
+    kind = PatternKind::Wave;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool parseColor(const std::string& value, sf::Color& color) {
+  int r, g, b;
+  if (std::sscanf(value.c_str(), "%d,%d,%d", &r, &g, &b) != 3) {
+    return false;
+  }
+  color = sf::Color(static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(g),
+                    static_cast<std::uint8_t>(b));
+  return true;
+}
+
+bool applyField(BulletPattern& pattern, const std::string& key, const std::string& value) {
+  if (key == "color") {
+    return parseColor(value, pattern.color);
+  }
+
+  char* end = nullptr;
+  float number = std::strtof(value.c_str(), &end);
+  if (end == value.c_str() || *end != '\0') {
+    return false;
+  }
+  if (key == "count") {
+    pattern.count = static_cast<int>(number);
+  } else if (key == "volleys") {
+    pattern.volleys = static_cast<int>(number);
+  } else if (key == "interval") {
+    pattern.interval = number;
+  } else if (key == "cooldown") {
+    pattern.cooldown = number;
+  } else if (key == "speed") {
+    pattern.speed = number;
+  } else if (key == "spread") {
+    pattern.spread = number;
+  } else if (key == "spin") {
+    pattern.spin = number;
+  } else if (key == "amplitude") {
+    pattern.amplitude = number;
+  } else if (key == "frequency") {
+    pattern.frequency = number;
+  } else if (key == "lifetime") {
+    pattern.lifetime = number;
+  } else if (key == "radius") {
+    pattern.radius = number;
+  } else if (key == "damage") {
+    pattern.damage = number;
+  } else {
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+BulletPatternLibrary BulletPatternLibrary::load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::clog << "[patterns] " << path << " not found, using built-in patterns"
+              << std::endl;
+    return builtin();
+  }
+  return parse(file, path);
+}
+
+BulletPatternLibrary BulletPatternLibrary::parse(std::istream& in,
+                                                 const std::string& sourceName) {
+  BulletPatternLibrary library;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    lineNumber++;
+    std::istringstream tokens(line);
+    std::string kindName;
+    if (!(tokens >> kindName) || kindName[0] == '#') {
+      continue;
+    }
+
+    auto fail = [&](const std::string& what) {
+      return std::runtime_error(sourceName + ":" + std::to_string(lineNumber) + ": " + what);
+    };
+
+    BulletPattern pattern;
+    if (!parseKind(kindName, pattern.kind)) {
+      throw fail("unknown pattern kind '" + kindName + "'");
+    }
+    if (!(tokens >> pattern.name)) {
+      throw fail("missing pattern name");
+    }
+
+    std::string field;
+    while (tokens >> field) {
+      size_t equals = field.find('=');
+      if (equals == std::string::npos ||
+          !applyField(pattern, field.substr(0, equals), field.substr(equals + 1))) {
+        throw fail("bad field '" + field + "'");
+      }
+    }
+    if (pattern.count < 1 || pattern.volleys < 1 || pattern.interval <= 0.0f ||
+        pattern.cooldown < 0.0f || pattern.lifetime <= 0.0f) {
+      throw fail("pattern '" + pattern.name + "' has out of range values");
+    }
+    library.patterns.push_back(pattern);
+  }
+
+  if (library.patterns.empty()) {
+    throw std::runtime_error(sourceName + ": no bullet patterns defined");
+  }
+  return library;
+}
+
+BulletPatternLibrary BulletPatternLibrary::builtin() {
+  std::istringstream definitions(
+      "aimed  sniper count=1 volleys=3 interval=0.12 cooldown=1.5 speed=90 damage=4\n"
+      "ring   pulse  count=16 cooldown=2.0 speed=40 color=255,120,120\n"
+      "spiral twister count=3 volleys=30 interval=0.08 cooldown=1.5 speed=45 spin=12 "
+      "color=140,200,255\n");
+  return parse(definitions, "built-in");
+}
+
+size_t BulletPatternLibrary::size() const { return patterns.size(); }
+
+const BulletPattern& BulletPatternLibrary::get(size_t index) const {
+  return patterns[index % patterns.size()];
+}
+
+const BulletPattern* BulletPatternLibrary::find(const std::string& name) const {
+  for (const BulletPattern& pattern : patterns) {
+    if (pattern.name == name) {
+      return &pattern;
+    }
+  }
+  return nullptr;
+}
+
+BulletEmitter::BulletEmitter(const BulletPattern* pattern)
+    : pattern(pattern),
+      timer(pattern ? pattern->cooldown : 0.0f),
+      volley(0),
+      angle(0.0f),
+      time(0.0f) {}
+
+void BulletEmitter::update(float dt, sf::Vector2f origin, sf::Vector2f target,
+                           bool active, BulletPool& pool) {
+  if (!pattern) {
+    return;
+  }
+  time += dt;
+  timer -= dt;
+
+  if (!active) {
+    volley = 0;
+    if (timer < 0.0f) {
+      timer = 0.0f;
+    }
+    return;
+  }
+
+  // Large steps (AI LOD) may cover several volleys; never more than a burst.
+  for (int fired = 0; timer <= 0.0f && fired < pattern->volleys; fired++) {
+    fireVolley(origin, target, pool);
+    volley++;
+    if (volley >= pattern->volleys) {
+      volley = 0;
+      timer += pattern->cooldown;
+    } else {
+      timer += pattern->interval;
+    }
+  }
+}
+
+void BulletEmitter::fireVolley(sf::Vector2f origin, sf::Vector2f target,
+                               BulletPool& pool) {
+  const BulletPattern& p = *pattern;
+  sf::Vector2f toTarget = target - origin;
+  float aim = std::atan2(toTarget.y, toTarget.x) / DEG_TO_RAD;
+
+  float base = 0.0f;
+  float step = 0.0f;
+  switch (p.kind) {
+    case PatternKind::Ring:
+      base = aim + angle;
+      step = 360.0f / p.count;
+      break;
+    case PatternKind::Spiral:
+      base = angle;
+      step = 360.0f / p.count;
+      break;
+    case PatternKind::AimedBurst:
+      base = aim - p.spread / 2.0f;
+      step = p.count > 1 ? p.spread / (p.count - 1) : 0.0f;
+      break;
+    case PatternKind::Wave:
+      base = aim + p.amplitude * std::sin(2.0f * 3.14159265f * p.frequency * time) -
+             p.spread / 2.0f;
+      step = p.count > 1 ? p.spread / (p.count - 1) : 0.0f;
+      break;
+  }
+  if (p.count == 1 && (p.kind == PatternKind::AimedBurst || p.kind == PatternKind::Wave)) {
+    base += p.spread / 2.0f;
+  }
+
+  for (int i = 0; i < p.count; i++) {
+    float radians = (base + step * i) * DEG_TO_RAD;
+    sf::Vector2f velocity(std::cos(radians) * p.speed, std::sin(radians) * p.speed);
+    if (!pool.spawn(origin, velocity, p)) {
+      break;
+    }
+  }
+  angle = std::fmod(angle + p.spin, 360.0f);
+}
@@ -0,0 +1,75 @@
+#ifndef BULLETPATTERN_H
+#define BULLETPATTERN_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+class BulletPool;
+
+enum class PatternKind : std::uint8_t {
+  Ring,        // `count` bullets evenly around the emitter, first one aimed
+  Spiral,      // `count` evenly spaced arms that keep turning by `spin`
+  AimedBurst,  // fan of `count` bullets across `spread` towards the target
+  Wave,        // aimed fan whose centre sweeps by `amplitude` at `frequency`
+};
+
+// One declarative pattern. A burst is `volleys` volleys `interval` seconds
+// apart, followed by `cooldown` seconds of silence. Angles are in degrees.
+struct BulletPattern {
+  std::string name;
+  PatternKind kind = PatternKind::AimedBurst;
+  int count = 1;
+  int volleys = 1;
+  float interval = 0.1f;
+  float cooldown = 1.5f;
+  float speed = 60.0f;
+  float spread = 0.0f;
+  float spin = 0.0f;
+  float amplitude = 0.0f;
+  float frequency = 0.0f;
+  float lifetime = 4.0f;
+  float radius = 0.8f;
+  float damage = 3.0f;
+  sf::Color color = sf::Color::White;
+};
+
+// Patterns parsed from a text file with one pattern per line:
+//   <ring|spiral|aimed|wave> <name> [key=value ...]
+// Blank lines and lines starting with '#' are ignored.
+class BulletPatternLibrary {
+  std::vector<BulletPattern> patterns;
+
+ public:
+  // Falls back to the built-in set when the file is missing; throws
+  // std::runtime_error on malformed definitions.
+  static BulletPatternLibrary load(const std::string& path);
+  static BulletPatternLibrary parse(std::istream& in, const std::string& sourceName);
+  static BulletPatternLibrary builtin();
+
+  size_t size() const;
+  const BulletPattern& get(size_t index) const;
+  const BulletPattern* find(const std::string& name) const;
+};
+
+// Runs a pattern for one shooter and spawns its bullets into the shared pool.
+class BulletEmitter {
+  const BulletPattern* pattern;
+  float timer;
+  int volley;
+  float angle;
+  float time;
+
+  void fireVolley(sf::Vector2f origin, sf::Vector2f target, BulletPool& pool);
+
+ public:
+  explicit BulletEmitter(const BulletPattern* pattern = nullptr);
+
+  // Inactive emitters keep counting down but hold fire and abandon any
+  // burst in progress.
+  void update(float dt, sf::Vector2f origin, sf::Vector2f target, bool active,
+              BulletPool& pool);
+};
+
+#endif  // BULLETPATTERN_H
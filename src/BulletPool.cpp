@@ -0,0 +1,149 @@
+#include "BulletPool.h"
+
+#include "BulletPattern.h"
+#include "RenderList.h"
+
+BulletPool::BulletPool(size_t capacity)
+    : posX(capacity),
+      posY(capacity),
+      velX(capacity),
+      velY(capacity),
+      life(capacity),
+      radius(capacity),
+      damage(capacity),
+      color(capacity),
+      ids(capacity),
+      count(0),
+      nextId(1) {}
+
+bool BulletPool::spawn(sf::Vector2f position, sf::Vector2f velocity,
+                       const BulletPattern& pattern) {
+  if (count == posX.size()) {
+    return false;
+  }
+  posX[count] = position.x;
+  posY[count] = position.y;
+  velX[count] = velocity.x;
+  velY[count] = velocity.y;
+  life[count] = pattern.lifetime;
+  radius[count] = pattern.radius;
+  damage[count] = pattern.damage;
+  color[count] = pattern.color;
+  ids[count] = nextId++;
+  count++;
+  return true;
+}
+
+void BulletPool::update(float dt, const sf::FloatRect& bounds) {
+  // Integration touches only the arrays it needs so it vectorizes.
+  float* x = posX.data();
+  float* y = posY.data();
+  const float* vx = velX.data();
+  const float* vy = velY.data();
+  float* remaining = life.data();
+  for (size_t i = 0; i < count; i++) {
+    x[i] += vx[i] * dt;
+    y[i] += vy[i] * dt;
+    remaining[i] -= dt;
+  }
+
+  float left = bounds.position.x;
+  float top = bounds.position.y;
+  float right = left + bounds.size.x;
+  float bottom = top + bounds.size.y;
+
+  size_t kept = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (remaining[i] <= 0.0f || x[i] < left || x[i] > right || y[i] < top ||
+        y[i] > bottom) {
+      continue;
+    }
+    if (kept != i) {
+      posX[kept] = posX[i];
+      posY[kept] = posY[i];
+      velX[kept] = velX[i];
+      velY[kept] = velY[i];
+      life[kept] = life[i];
+      radius[kept] = radius[i];
+      damage[kept] = damage[i];
+      color[kept] = color[i];
+      ids[kept] = ids[i];
+    }
+    kept++;
+  }
+  count = kept;
+}
+
+void BulletPool::kill(size_t index) {
+  if (index < count) {
+    life[index] = 0.0f;
+  }
+}
+
+void BulletPool::clear() { count = 0; }
+
+void BulletPool::detectHits(const sf::FloatRect& target,
+                            std::vector<std::uint32_t>& out) const {
+  float left = target.position.x;
+  float top = target.position.y;
+  float right = left + target.size.x;
+  float bottom = top + target.size.y;
+
+  for (size_t i = 0; i < count; i++) {
+    // Distance from the bullet centre to the nearest point of the box.
+    float nearestX = posX[i] < left ? left : (posX[i] > right ? right : posX[i]);
+    float nearestY = posY[i] < top ? top : (posY[i] > bottom ? bottom : posY[i]);
+    float dx = posX[i] - nearestX;
+    float dy = posY[i] - nearestY;
+    if (dx * dx + dy * dy < radius[i] * radius[i] && life[i] > 0.0f) {
+      out.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+}
+
+void BulletPool::appendVertices(const sf::FloatRect& visible,
+                                std::vector<sf::Vertex>& out) const {
+  float left = visible.position.x;
+  float top = visible.position.y;
+  float right = left + visible.size.x;
+  float bottom = top + visible.size.y;
+
+  for (size_t i = 0; i < count; i++) {
+    float r = radius[i];
+    if (life[i] <= 0.0f || posX[i] + r < left || posX[i] - r > right ||
+        posY[i] + r < top || posY[i] - r > bottom) {
+      continue;
+    }
+    sf::Vector2f a(posX[i] - r, posY[i] - r);
+    sf::Vector2f b(posX[i] + r, posY[i] - r);
+    sf::Vector2f c(posX[i] - r, posY[i] + r);
+    sf::Vector2f d(posX[i] + r, posY[i] + r);
+    const sf::Color& tint = color[i];
+    out.push_back({a, tint, {}});
+    out.push_back({b, tint, {}});
+    out.push_back({c, tint, {}});
+    out.push_back({b, tint, {}});
+    out.push_back({d, tint, {}});
+    out.push_back({c, tint, {}});
+  }
+}
+
+size_t BulletPool::size() const { return count; }
+
+size_t BulletPool::getCapacity() const { return posX.size(); }
+
+bool BulletPool::isLive(size_t index) const { return life[index] > 0.0f; }
+
+float BulletPool::getDamage(size_t index) const { return damage[index]; }
+
+sf::Vector2f BulletPool::getPosition(size_t index) const {
+  return {posX[index], posY[index]};
+}
+
+std::uint32_t BulletPool::getId(size_t index) const { return ids[index]; }
+
+void BulletPool::addToRenderList(const sf::FloatRect& visible, RenderList& list) const {
+  std::vector<sf::Vertex>& vertices = list.addVertices(sf::PrimitiveType::Triangles);
+  vertices.reserve(count * 6);
+  appendVertices(visible, vertices);
+}
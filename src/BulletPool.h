@@ -0,0 +1,59 @@
+#ifndef BULLETPOOL_H
+#define BULLETPOOL_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+struct BulletPattern;
+class RenderList;
+
+// Every enemy bullet in the game, stored as parallel arrays sized once up
+// front. Live bullets occupy [0, size()); update() compacts in place and
+// keeps spawn order, so indices are stable between update() calls. Every
+// bullet also gets an id, increasing in spawn order, that stays with it for
+// its whole life.
+class BulletPool {
+  std::vector<float> posX;
+  std::vector<float> posY;
+  std::vector<float> velX;
+  std::vector<float> velY;
+  std::vector<float> life;
+  std::vector<float> radius;
+  std::vector<float> damage;
+  std::vector<sf::Color> color;
+  std::vector<std::uint32_t> ids;
+  size_t count;
+  std::uint32_t nextId;
+
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 65536;
+
+  explicit BulletPool(size_t capacity = DEFAULT_CAPACITY);
+
+  // Returns false (and drops the bullet) when the pool is full.
+  bool spawn(sf::Vector2f position, sf::Vector2f velocity, const BulletPattern& pattern);
+  // Moves every bullet, then drops expired ones and those outside `bounds`.
+  void update(float dt, const sf::FloatRect& bounds);
+  // Marks a bullet spent; it stops colliding and drawing and is removed by
+  // the next update().
+  void kill(size_t index);
+  void clear();
+
+  // Appends the index of every live bullet whose circle touches `target`.
+  void detectHits(const sf::FloatRect& target, std::vector<std::uint32_t>& out) const;
+  // Two triangles per bullet inside `visible`, ready for one draw call.
+  void appendVertices(const sf::FloatRect& visible, std::vector<sf::Vertex>& out) const;
+  // Records every bullet inside `visible` as one vertex batch in `list`.
+  // This is how the game draws bullets; the benchmark calls it too.
+  void addToRenderList(const sf::FloatRect& visible, RenderList& list) const;
+
+  size_t size() const;
+  size_t getCapacity() const;
+  // False for bullets kill()ed since the last update().
+  bool isLive(size_t index) const;
+  float getDamage(size_t index) const;
+  sf::Vector2f getPosition(size_t index) const;
+  std::uint32_t getId(size_t index) const;
+};
+
+#endif  // BULLETPOOL_H
@@ -0,0 +1,103 @@
+#include "CollisionSystem.h"
+
+#include "BulletPool.h"
+#include "Enemy.h"
+#include "Player.h"
+#include "Projectile.h"
+#include "ThreadPool.h"
+
+CollisionSystem::CollisionSystem(ThreadPool* threadPool)
+    : threadPool(threadPool) {}
+
+void CollisionSystem::setThreadPool(ThreadPool* pool) { threadPool = pool; }
+
+bool CollisionSystem::overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+  return a.position.x < b.position.x + b.size.x &&
+         a.position.x + a.size.x > b.position.x &&
+         a.position.y < b.position.y + b.size.y &&
+         a.position.y + a.size.y > b.position.y;
+}
+
+void CollisionSystem::gather(const Player& player,
+                             const std::vector<Enemy*>& enemies) {
+  playerShotBounds.clear();
+  for (const Projectile* projectile : player.getProjectiles()) {
+    playerShotBounds.push_back(projectile->getSprite().getGlobalBounds());
+  }
+
+  enemyBounds.clear();
+  for (const Enemy* enemy : enemies) {
+    enemyBounds.push_back(enemy->getGlobalBounds());
+  }
+}
+
+void CollisionSystem::detectShotRange(const std::vector<sf::FloatRect>& shots,
+                                      const std::vector<sf::FloatRect>& targets,
+                                      size_t begin, size_t end,
+                                      std::vector<HitEvent>& out) {
+  for (size_t projIndex = begin; projIndex < end; projIndex++) {
+    for (size_t targetIndex = 0; targetIndex < targets.size(); targetIndex++) {
+      if (overlaps(shots[projIndex], targets[targetIndex])) {
+        out.push_back({HitKind::PlayerShotEnemy,
+                       static_cast<std::uint32_t>(projIndex), 0,
+                       static_cast<std::uint32_t>(targetIndex),
+                       PLAYER_SHOT_DAMAGE});
+        break;
+      }
+    }
+  }
+}
+
+void CollisionSystem::detectShots(const std::vector<sf::FloatRect>& shots,
+                                  const std::vector<sf::FloatRect>& targets,
+                                  std::vector<HitEvent>& out) {
+  if (!threadPool) {
+    detectShotRange(shots, targets, 0, shots.size(), out);
+    return;
+  }
+
+  size_t ranges = threadPool->rangesFor(shots.size(), MIN_SHOTS_PER_RANGE);
+  if (rangeHits.size() < ranges) {
+    rangeHits.resize(ranges);
+  }
+  for (size_t i = 0; i < ranges; i++) {
+    rangeHits[i].clear();
+  }
+
+  threadPool->parallelFor(
+      shots.size(), MIN_SHOTS_PER_RANGE,
+      [&](size_t begin, size_t end, size_t range) {
+        detectShotRange(shots, targets, begin, end, rangeHits[range]);
+      });
+
+  for (size_t i = 0; i < ranges; i++) {
+    out.insert(out.end(), rangeHits[i].begin(), rangeHits[i].end());
+  }
+}
+
+void CollisionSystem::detect(const Player& player,
+                             const std::vector<Enemy*>& enemies,
+                             const BulletPool& bullets,
+                             std::vector<HitEvent>& out) {
+  gather(player, enemies);
+
+  detectShots(playerShotBounds, enemyBounds, out);
+
+  sf::FloatRect playerBounds = player.getGlobalBounds();
+  sf::Vector2f hitboxSize = playerBounds.size * PLAYER_HITBOX_SCALE;
+  sf::FloatRect hitbox(playerBounds.getCenter() - hitboxSize / 2.0f, hitboxSize);
+  bulletHits.clear();
+  bullets.detectHits(hitbox, bulletHits);
+  for (std::uint32_t bulletIndex : bulletHits) {
+    out.push_back({HitKind::EnemyShotPlayer, bulletIndex, 0, 0,
+                   bullets.getDamage(bulletIndex)});
+  }
+
+  for (size_t enemyIndex = 0; enemyIndex < enemyBounds.size(); enemyIndex++) {
+    if (overlaps(enemyBounds[enemyIndex], playerBounds)) {
+      out.push_back({HitKind::EnemyRammedPlayer, 0,
+                     static_cast<std::uint32_t>(enemyIndex), 0,
+                     static_cast<float>(enemies[enemyIndex]->getDamage())});
+    }
+  }
+}
@@ -0,0 +1,68 @@
+#ifndef COLLISIONSYSTEM_H
+#define COLLISIONSYSTEM_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+class BulletPool;
+class Enemy;
+class Player;
+class ThreadPool;
+
+enum class HitKind : std::uint8_t {
+  PlayerShotEnemy,    // player projectile `source` hit enemy `target`
+  EnemyShotPlayer,    // bullet `source` in the shared bullet pool hit the player
+  EnemyRammedPlayer,  // enemy `owner` touched the player
+};
+
+// Compact record of one overlap found during detection. Indices refer to the
+// entity vectors as they were when detect() ran; nothing is mutated until
+// the resolution stage consumes the queue.
+struct HitEvent {
+  HitKind kind;
+  std::uint32_t source;
+  std::uint32_t owner;
+  std::uint32_t target;
+  float damage;
+};
+
+class CollisionSystem {
+ private:
+  std::vector<sf::FloatRect> playerShotBounds;
+  std::vector<sf::FloatRect> enemyBounds;
+  std::vector<std::uint32_t> bulletHits;
+  std::vector<std::vector<HitEvent>> rangeHits;
+  ThreadPool* threadPool;
+
+  void gather(const Player& player, const std::vector<Enemy*>& enemies);
+  static void detectShotRange(const std::vector<sf::FloatRect>& shots,
+                              const std::vector<sf::FloatRect>& targets,
+                              size_t begin, size_t end,
+                              std::vector<HitEvent>& out);
+
+ public:
+  static constexpr float PLAYER_SHOT_DAMAGE = 25.0f;
+  // Enemy bullets test against this fraction of the player sprite, centred.
+  static constexpr float PLAYER_HITBOX_SCALE = 0.5f;
+  // Below this many shots per range the threading overhead isn't worth it.
+  static constexpr size_t MIN_SHOTS_PER_RANGE = 256;
+
+  explicit CollisionSystem(ThreadPool* threadPool = nullptr);
+  void setThreadPool(ThreadPool* pool);
+
+  static bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b);
+
+  // Narrow phase of shots against targets. Each shot hits at most the first
+  // target it overlaps. Ranges of shots run on the thread pool, each into
+  // its own buffer, and the buffers are appended in range order so the
+  // result is identical for any thread count.
+  void detectShots(const std::vector<sf::FloatRect>& shots,
+                   const std::vector<sf::FloatRect>& targets,
+                   std::vector<HitEvent>& out);
+
+  // Read-only pass: appends one event per overlap to `out`.
+  void detect(const Player& player, const std::vector<Enemy*>& enemies,
+              const BulletPool& bullets, std::vector<HitEvent>& out);
+};
+
+#endif  // COLLISIONSYSTEM_H
@@ -0,0 +1,142 @@
+#include "Enemy.h"
+
+#include <cmath>
+#include <string>
+
+#include "BulletPool.h"
+#include "Player.h"
+
+static sf::Texture &getEnemyTexture(int spriteType) {
+  static sf::Texture textures[3];
+  static bool loaded[3] = {false, false, false};
+
+  if (spriteType < 0 || spriteType > 2) {
+    spriteType = 0;
+  }
+  if (!loaded[spriteType]) {
+    std::string file = "Gray" + std::to_string(spriteType + 1) + ".png";
+    if (!textures[spriteType].loadFromFile(file)) {
+      sf::Image fallbackImage(sf::Vector2u{32, 32}, sf::Color::Red);
+      (void)textures[spriteType].loadFromImage(fallbackImage);
+    }
+    textures[spriteType].setSmooth(false);
+    loaded[spriteType] = true;
+  }
+  return textures[spriteType];
+}
+
+Enemy::Enemy(sf::Vector2f startPos, int spriteType,
+             const BulletPattern* pattern)
+    : sprite(getEnemyTexture(spriteType)),
+      position(startPos),
+      velocity({0.f, 0.f}),
+      speed(80.0f),
+      health(100.0f),
+      maxHealth(100.0f),
+      damage_to_player(10),
+      detectionRange(400.0f),
+      shootingRange(120.0f),
+      emitter(pattern),
+      id(0) {
+  sprite.setScale({0.8f, 0.8f});
+
+  sf::FloatRect bounds = sprite.getLocalBounds();
+  sprite.setOrigin({bounds.size.x / 2.0f, bounds.size.y / 2.0f});
+  sprite.setPosition(position);
+}
+
+Enemy::~Enemy() = default;
+
+void Enemy::update(float dt, const Player& player, const sf::View& view,
+                   BulletPool& bullets, sf::Vector2f steering) {
+  if (canSeePlayer(player)) {
+    moveTowardsPlayer(player, dt, steering);
+    updateRotation(player);
+  }
+
+  shoot(player, dt, isInShootingRange(player) && isVisibleInView(view), bullets);
+  sprite.setPosition(position);
+}
+
+void Enemy::render(RenderList& list) const { list.addSprite(sprite); }
+
+void Enemy::moveTowardsPlayer(const Player& player, float dt, sf::Vector2f steering) {
+  sf::Vector2f direction = player.getPos() - position;
+  float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+  if (length <= 0.0f) {
+    return;
+  }
+
+  direction = direction / length + steering;
+  length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+  if (length > 0.0f) {
+    velocity = direction / length * speed;
+    position += velocity * dt;
+  }
+}
+
+void Enemy::updateRotation(const Player& player) {
+  sf::Vector2f direction = player.getPos() - position;
+  if (direction.x != 0.0f || direction.y != 0.0f) {
+    float angle = std::atan2(direction.y, direction.x) * 180.0f / 3.14159f;
+    sprite.setRotation(sf::degrees(angle + 90.0f));
+  }
+}
+
+void Enemy::shoot(const Player& player, float dt, bool active, BulletPool& bullets) {
+  emitter.update(dt, position, player.getPos(), active, bullets);
+}
+
+bool Enemy::canSeePlayer(const Player& player) const {
+  sf::Vector2f offset = player.getPos() - position;
+  return offset.x * offset.x + offset.y * offset.y <=
+         detectionRange * detectionRange;
+}
+
+bool Enemy::isInShootingRange(const Player& player) const {
+  sf::Vector2f offset = player.getPos() - position;
+  return offset.x * offset.x + offset.y * offset.y <=
+         shootingRange * shootingRange;
+}
+
+bool Enemy::isVisibleInView(const sf::View& view) const {
+  sf::FloatRect viewBounds(view.getCenter() - view.getSize() / 2.f,
+                           view.getSize());
+  return viewBounds.contains(position);
+}
+
+bool Enemy::checkCollisionWithPlayer(const Player& player) const {
+  return getGlobalBounds().findIntersection(player.getGlobalBounds()).has_value();
+}
+
+void Enemy::takeDamage(float damage) {
+  health -= damage;
+  if (health < 0.0f) {
+    health = 0.0f;
+  }
+}
+
+bool Enemy::isDead() const { return health <= 0.0f; }
+
+sf::Vector2f Enemy::getPosition() const { return position; }
+
+sf::Vector2f Enemy::getVelocity() const { return velocity; }
+
+sf::FloatRect Enemy::getGlobalBounds() const { return sprite.getGlobalBounds(); }
+
+const sf::Sprite& Enemy::getSprite() const { return sprite; }
+
+float Enemy::getHealth() const { return health; }
+
+int Enemy::getDamage() const { return damage_to_player; }
+
+std::uint32_t Enemy::getId() const { return id; }
+
+void Enemy::setPosition(sf::Vector2f pos) {
+  position = pos;
+  sprite.setPosition(position);
+}
+
+void Enemy::setHealth(float hp) { health = hp; }
+
+void Enemy::setId(std::uint32_t newId) { id = newId; }
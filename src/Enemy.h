@@ -2,15 +2,19 @@
 #define ENEMY_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 
+#include "AllocTracker.h"
+#include "BulletPattern.h"
+#include "RenderList.h"
+
 // Forward declarations
+class BulletPool;
 class Player;
-class Projectile;
 
-class Enemy {
+class Enemy : public TrackedAllocation<AllocCategory::Enemy> {
 private:
-    sf::Texture texture;
     sf::Sprite sprite;
     sf::Vector2f position;
     sf::Vector2f velocity;
@@ -18,30 +22,29 @@ private:
     float health;
     float maxHealth;
     int damage_to_player;
-    float shootCooldown;
-    float lastShotTime;
     float detectionRange;
     float shootingRange;
-    std::vector<Projectile*> projectiles;
-    sf::RenderWindow* window;
+    BulletEmitter emitter;
+    std::uint32_t id;
     
 public:
     // Constructor and destructor
-    Enemy(sf::Vector2f startPos, sf::RenderWindow* window, int spriteType = 0);
+    Enemy(sf::Vector2f startPos, int spriteType = 0,
+          const BulletPattern* pattern = nullptr);
     ~Enemy();
     
     // Core functions
-    void update(float dt, const Player& player, const sf::View& view);
-    void render(sf::RenderWindow& window) const;
+    // `steering` comes from the flock and bends the direct path to the player.
+    void update(float dt, const Player& player, const sf::View& view, BulletPool& bullets,
+                sf::Vector2f steering = {0.f, 0.f});
+    void render(RenderList& list) const;
     
     // Movement and AI
-    void moveTowardsPlayer(const Player& player, float dt);
+    void moveTowardsPlayer(const Player& player, float dt, sf::Vector2f steering);
     void updateRotation(const Player& player);
     
     // Combat functions
-    void shoot(const Player& player, float dt);
-    void updateProjectiles(float dt);
-    void removeProjectile(size_t index);
+    void shoot(const Player& player, float dt, bool active, BulletPool& bullets);
     bool canSeePlayer(const Player& player) const;
     bool isInShootingRange(const Player& player) const;
     bool isVisibleInView(const sf::View& view) const;
@@ -53,15 +56,17 @@ public:
     
     // Getters
     sf::Vector2f getPosition() const;
+    sf::Vector2f getVelocity() const;
     sf::FloatRect getGlobalBounds() const;
     const sf::Sprite& getSprite() const;
-    const std::vector<Projectile*>& getProjectiles() const;
     float getHealth() const;
     int getDamage() const;
+    std::uint32_t getId() const;
     
     // Setters
     void setPosition(sf::Vector2f pos);
     void setHealth(float hp);
+    void setId(std::uint32_t newId);
 };
 
 #endif
\ No newline at end of file
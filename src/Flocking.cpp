@@ -0,0 +1,68 @@
+#include "Flocking.h"
+
+#include <cmath>
+
+#include "Enemy.h"
+
+Flock::Flock(const FlockingParams& params)
+    : params(params), grid(params.neighborRadius) {}
+
+void Flock::build(const std::vector<Enemy*>& enemies) {
+  positions.resize(enemies.size());
+  velocities.resize(enemies.size());
+  for (size_t i = 0; i < enemies.size(); i++) {
+    positions[i] = enemies[i]->getPosition();
+    velocities[i] = enemies[i]->getVelocity();
+  }
+  grid.build(positions);
+}
+
+sf::Vector2f Flock::steer(size_t index) const {
+  const size_t maxNeighbors = 32;
+  std::uint32_t neighbors[maxNeighbors];
+  size_t limit = params.maxNeighbors < maxNeighbors ? params.maxNeighbors : maxNeighbors;
+  size_t count = grid.query(positions[index], params.neighborRadius,
+                            static_cast<std::uint32_t>(index), limit, neighbors);
+  if (count == 0) {
+    return {0.0f, 0.0f};
+  }
+
+  sf::Vector2f self = positions[index];
+  sf::Vector2f separation(0.0f, 0.0f);
+  sf::Vector2f averageVelocity(0.0f, 0.0f);
+  sf::Vector2f center(0.0f, 0.0f);
+  float sepRadiusSq = params.separationRadius * params.separationRadius;
+
+  for (size_t n = 0; n < count; n++) {
+    sf::Vector2f other = positions[neighbors[n]];
+    sf::Vector2f away = self - other;
+    float distSq = away.x * away.x + away.y * away.y;
+    if (distSq < sepRadiusSq) {
+      // Push harder the closer they are; stacked enemies get a fixed nudge.
+      if (distSq > 1e-4f) {
+        float dist = std::sqrt(distSq);
+        separation += away / dist * (1.0f - dist / params.separationRadius);
+      } else {
+        separation += sf::Vector2f(index < neighbors[n] ? 1.0f : -1.0f, 0.0f);
+      }
+    }
+    averageVelocity += velocities[neighbors[n]];
+    center += other;
+  }
+
+  float inverse = 1.0f / static_cast<float>(count);
+  averageVelocity *= inverse;
+  center *= inverse;
+
+  sf::Vector2f alignment(0.0f, 0.0f);
+  float speedSq = averageVelocity.x * averageVelocity.x + averageVelocity.y * averageVelocity.y;
+  if (speedSq > 1e-4f) {
+    alignment = averageVelocity / std::sqrt(speedSq);
+  }
+  sf::Vector2f cohesion = (center - self) / params.neighborRadius;
+
+  return separation * params.separationWeight + alignment * params.alignmentWeight +
+         cohesion * params.cohesionWeight;
+}
+
+size_t Flock::getMaxCellOccupancy() const { return grid.getMaxOccupancy(); }
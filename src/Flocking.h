@@ -0,0 +1,41 @@
+#ifndef FLOCKING_H
+#define FLOCKING_H
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "SpatialGrid.h"
+
+class Enemy;
+
+struct FlockingParams {
+  float neighborRadius = 40.0f;    // alignment and cohesion reach
+  float separationRadius = 28.0f;  // roughly one enemy sprite
+  float separationWeight = 5.0f;
+  float alignmentWeight = 0.4f;
+  float cohesionWeight = 0.3f;
+  size_t maxNeighbors = 8;         // bounds the per-enemy cost in dense packs
+};
+
+// Boids-style steering for the enemy swarm. build() snapshots positions and
+// velocities into a spatial grid once per tick; steer() then looks at a
+// capped number of nearby enemies only.
+class Flock {
+  FlockingParams params;
+  SpatialGrid grid;
+  std::vector<sf::Vector2f> positions;
+  std::vector<sf::Vector2f> velocities;
+
+ public:
+  explicit Flock(const FlockingParams& params = FlockingParams());
+
+  void build(const std::vector<Enemy*>& enemies);
+
+  // Offset to add to enemy `index`'s unit direction towards its target.
+  sf::Vector2f steer(size_t index) const;
+
+  // Densest grid cell in the last build, a cheap clumping indicator.
+  size_t getMaxCellOccupancy() const;
+};
+
+#endif  // FLOCKING_H
@@ -0,0 +1,113 @@
+#include "FrameGovernor.h"
+
+#include <cstdio>
+#include <iostream>
+
+namespace {
+const FrameBudgetKnobs kLevels[] = {
+    {1.00f, 400.0f, 200, 2, 1.00f},
+    {1.25f, 300.0f, 120, 2, 1.00f},
+    {1.50f, 220.0f, 80, 1, 0.85f},
+    {2.00f, 150.0f, 50, 1, 0.70f},
+};
+constexpr int kLevelCount = sizeof(kLevels) / sizeof(kLevels[0]);
+
+// Exponential smoothing factor for the per-frame timings.
+constexpr float kSmoothing = 0.1f;
+// Hysteresis: degrade quickly when over budget, recover slowly and only with
+// plenty of headroom so the governor doesn't oscillate between two levels.
+constexpr float kDegradeRatio = 1.0f;
+constexpr float kRecoverRatio = 0.7f;
+constexpr int kDegradeFrames = 30;
+constexpr int kRecoverFrames = 180;
+constexpr int kCooldownFrames = 60;
+}  // namespace
+
+FrameGovernor::FrameGovernor(float targetFrameMs)
+    : targetFrameMs(targetFrameMs),
+      smoothedUpdateMs(0.0f),
+      smoothedRenderMs(0.0f),
+      level(0),
+      framesOverBudget(0),
+      framesUnderBudget(0),
+      cooldownFrames(0),
+      hasSamples(false) {}
+
+bool FrameGovernor::recordFrame(float updateMs, float renderMs) {
+  if (!hasSamples) {
+    smoothedUpdateMs = updateMs;
+    smoothedRenderMs = renderMs;
+    hasSamples = true;
+  } else {
+    smoothedUpdateMs += (updateMs - smoothedUpdateMs) * kSmoothing;
+    smoothedRenderMs += (renderMs - smoothedRenderMs) * kSmoothing;
+  }
+
+  if (cooldownFrames > 0) {
+    cooldownFrames--;
+    return false;
+  }
+
+  float frameMs = smoothedUpdateMs + smoothedRenderMs;
+
+  if (frameMs > targetFrameMs * kDegradeRatio) {
+    framesOverBudget++;
+    framesUnderBudget = 0;
+  } else if (frameMs < targetFrameMs * kRecoverRatio) {
+    framesUnderBudget++;
+    framesOverBudget = 0;
+  } else {
+    framesOverBudget = 0;
+    framesUnderBudget = 0;
+  }
+
+  if (framesOverBudget >= kDegradeFrames && level < kLevelCount - 1) {
+    changeLevel(level + 1);
+    return true;
+  }
+  if (framesUnderBudget >= kRecoverFrames && level > 0) {
+    changeLevel(level - 1);
+    return true;
+  }
+  return false;
+}
+
+void FrameGovernor::changeLevel(int newLevel) {
+  std::clog << "[governor] level " << level << " -> " << newLevel
+            << " (update " << smoothedUpdateMs << " ms, render "
+            << smoothedRenderMs << " ms, budget " << targetFrameMs << " ms)"
+            << std::endl;
+
+  level = newLevel;
+  framesOverBudget = 0;
+  framesUnderBudget = 0;
+  cooldownFrames = kCooldownFrames;
+}
+
+const FrameBudgetKnobs& FrameGovernor::getKnobs() const {
+  return kLevels[level];
+}
+
+int FrameGovernor::getLevel() const { return level; }
+
+int FrameGovernor::getLevelCount() const { return kLevelCount; }
+
+float FrameGovernor::getTargetFrameMs() const { return targetFrameMs; }
+
+float FrameGovernor::getSmoothedUpdateMs() const { return smoothedUpdateMs; }
+
+float FrameGovernor::getSmoothedRenderMs() const { return smoothedRenderMs; }
+
+std::string FrameGovernor::describe() const {
+  const FrameBudgetKnobs& knobs = getKnobs();
+  char buffer[256];
+  std::snprintf(buffer, sizeof(buffer),
+                "Governor level %d/%d\n"
+                "Update %.2f ms  Render %.2f ms  Budget %.1f ms\n"
+                "Spawn x%.2f  AI LOD %.0f  Max enemies %zu  Chunk radius %d  "
+                "Scale cap %.2f",
+                level, kLevelCount - 1, smoothedUpdateMs, smoothedRenderMs,
+                targetFrameMs, knobs.spawnIntervalScale, knobs.aiLodDistance,
+                knobs.maxEnemies, knobs.chunkLoadDistance, knobs.renderScale);
+  return buffer;
+}
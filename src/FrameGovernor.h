@@ -0,0 +1,45 @@
+#ifndef FRAMEGOVERNOR_H
+#define FRAMEGOVERNOR_H
+#include <cstddef>
+#include <string>
+
+// Tunable load knobs for one quality level. Level 0 is full spectacle, higher
+// levels trade simulation and visual load for a stable frame rate.
+struct FrameBudgetKnobs {
+  float spawnIntervalScale;  // multiplier on the enemy spawn interval
+  float aiLodDistance;       // enemies further away update at reduced rate
+  std::size_t maxEnemies;    // hard cap on live enemies
+  int chunkLoadDistance;     // background chunk radius around the player
+  float renderScale;         // cap on the world pass resolution scale
+};
+
+class FrameGovernor {
+ private:
+  float targetFrameMs;
+  float smoothedUpdateMs;
+  float smoothedRenderMs;
+  int level;
+  int framesOverBudget;
+  int framesUnderBudget;
+  int cooldownFrames;
+  bool hasSamples;
+
+  void changeLevel(int newLevel);
+
+ public:
+  explicit FrameGovernor(float targetFrameMs = 16.6f);
+
+  // Feed the measured cost of one frame. Returns true when the quality level
+  // changed and the knobs should be re-applied.
+  bool recordFrame(float updateMs, float renderMs);
+
+  const FrameBudgetKnobs& getKnobs() const;
+  int getLevel() const;
+  int getLevelCount() const;
+  float getTargetFrameMs() const;
+  float getSmoothedUpdateMs() const;
+  float getSmoothedRenderMs() const;
+  std::string describe() const;
+};
+
+#endif  // FRAMEGOVERNOR_H
@@ -0,0 +1,157 @@
+#include "FramePacer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace {
+constexpr size_t kRecentFrames = 240;
+// Wake this long before the deadline and spin the rest, since sleep
+// granularity is typically 1-2 ms.
+const sf::Time kSpinMargin = sf::microseconds(2000);
+}  // namespace
+
+FramePacer::FramePacer(PacingMode mode, float targetFps)
+    : mode(mode),
+      targetFps(targetFps > 0.0f ? targetFps : 60.0f),
+      recentMs(kRecentFrames, 0.0f),
+      recentIndex(0),
+      recentCount(0),
+      frames(0),
+      meanMs(0.0),
+      m2(0.0),
+      maxMs(0.0),
+      sumDeltaMs(0.0),
+      previousMs(0.0f) {
+  lastFrameEnd = clock.getElapsedTime();
+  nextDeadline = lastFrameEnd;
+}
+
+void FramePacer::configure(sf::Window& window) const {
+  window.setFramerateLimit(0);
+  window.setVerticalSyncEnabled(mode == PacingMode::VSync || mode == PacingMode::Idle);
+}
+
+void FramePacer::endFrame() {
+  if (mode == PacingMode::Limiter) {
+    waitForDeadline();
+  }
+
+  sf::Time now = clock.getElapsedTime();
+  recordFrame((now - lastFrameEnd).asSeconds() * 1000.0f);
+  lastFrameEnd = now;
+}
+
+void FramePacer::resume() {
+  lastFrameEnd = clock.getElapsedTime();
+  nextDeadline = lastFrameEnd;
+}
+
+void FramePacer::waitForDeadline() {
+  const sf::Time frameTime = sf::seconds(1.0f / targetFps);
+  nextDeadline = nextDeadline + frameTime;
+
+  sf::Time now = clock.getElapsedTime();
+  // Fell more than a frame behind: re-anchor instead of bursting to catch up.
+  if (now > nextDeadline + frameTime) {
+    nextDeadline = now;
+    return;
+  }
+
+  if (nextDeadline - now > kSpinMargin) {
+    sf::sleep(nextDeadline - now - kSpinMargin);
+  }
+  while (clock.getElapsedTime() < nextDeadline) {
+    std::this_thread::yield();
+  }
+}
+
+void FramePacer::recordFrame(float frameMs) {
+  recentMs[recentIndex] = frameMs;
+  recentIndex = (recentIndex + 1) % kRecentFrames;
+  if (recentCount < kRecentFrames) recentCount++;
+
+  frames++;
+  double delta = frameMs - meanMs;
+  meanMs += delta / frames;
+  m2 += delta * (frameMs - meanMs);
+  if (frameMs > maxMs) maxMs = frameMs;
+  if (frames > 1) sumDeltaMs += std::fabs(frameMs - previousMs);
+  previousMs = frameMs;
+}
+
+PacingMode FramePacer::getMode() const { return mode; }
+
+bool FramePacer::isIdleMode() const { return mode == PacingMode::Idle; }
+
+float FramePacer::getTargetFps() const { return targetFps; }
+
+std::string FramePacer::describe() const {
+  if (recentCount == 0) {
+    return std::string("Pacing ") + modeName(mode);
+  }
+
+  double mean = 0.0, maxFrame = 0.0, sumDelta = 0.0;
+  for (size_t i = 0; i < recentCount; i++) {
+    mean += recentMs[i];
+    if (recentMs[i] > maxFrame) maxFrame = recentMs[i];
+  }
+  mean /= recentCount;
+
+  double variance = 0.0;
+  for (size_t i = 0; i < recentCount; i++) {
+    variance += (recentMs[i] - mean) * (recentMs[i] - mean);
+  }
+  // Walk the ring in time order for frame-to-frame jitter.
+  size_t oldest = recentCount < kRecentFrames ? 0 : recentIndex;
+  for (size_t i = 1; i < recentCount; i++) {
+    float current = recentMs[(oldest + i) % kRecentFrames];
+    float previous = recentMs[(oldest + i - 1) % kRecentFrames];
+    sumDelta += std::fabs(current - previous);
+  }
+
+  char buffer[160];
+  std::snprintf(buffer, sizeof(buffer),
+                "Pacing %s%s  frame %.2f ms  stddev %.2f  jitter %.2f  max %.2f",
+                modeName(mode),
+                mode == PacingMode::Limiter
+                    ? (" @" + std::to_string(static_cast<int>(targetFps))).c_str()
+                    : "",
+                mean, std::sqrt(variance / recentCount),
+                recentCount > 1 ? sumDelta / (recentCount - 1) : 0.0, maxFrame);
+  return buffer;
+}
+
+void FramePacer::report(std::ostream& out) const {
+  double stddev = frames > 1 ? std::sqrt(m2 / (frames - 1)) : 0.0;
+  double jitter = frames > 1 ? sumDeltaMs / (frames - 1) : 0.0;
+  out << "[pacing] mode " << modeName(mode) << ": " << frames
+      << " frames, mean " << meanMs << " ms, stddev " << stddev
+      << " ms, frame-to-frame jitter " << jitter << " ms, max " << maxMs
+      << " ms" << std::endl;
+}
+
+const char* FramePacer::modeName(PacingMode mode) {
+  switch (mode) {
+    case PacingMode::Unlimited:
+      return "unlimited";
+    case PacingMode::VSync:
+      return "vsync";
+    case PacingMode::Limiter:
+      return "limit";
+    case PacingMode::Idle:
+      return "idle";
+  }
+  return "unknown";
+}
+
+bool FramePacer::parseMode(const std::string& name, PacingMode& mode) {
+  for (PacingMode candidate : {PacingMode::Unlimited, PacingMode::VSync,
+                               PacingMode::Limiter, PacingMode::Idle}) {
+    if (name == modeName(candidate)) {
+      mode = candidate;
+      return true;
+    }
+  }
+  return false;
+}
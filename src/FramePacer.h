@@ -0,0 +1,64 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class PacingMode {
+  Unlimited,  // no pacing at all
+  VSync,      // let display() wait for the vertical blank
+  Limiter,    // sleep, then spin, until the target frame time
+  Idle,       // vsync while the scene changes, block on events when static
+};
+
+// Paces the main loop and keeps frame-time jitter statistics.
+class FramePacer {
+ private:
+  PacingMode mode;
+  float targetFps;
+  sf::Clock clock;
+  sf::Time lastFrameEnd;
+  sf::Time nextDeadline;
+
+  // Rolling window for the overlay
+  std::vector<float> recentMs;
+  size_t recentIndex;
+  size_t recentCount;
+
+  // Whole-run statistics (Welford)
+  std::uint64_t frames;
+  double meanMs;
+  double m2;
+  double maxMs;
+  double sumDeltaMs;  // sum of |frame[i] - frame[i-1]|
+  float previousMs;
+
+  void waitForDeadline();
+  void recordFrame(float frameMs);
+
+ public:
+  FramePacer(PacingMode mode = PacingMode::VSync, float targetFps = 60.0f);
+
+  // Apply window-side settings. Must run on the thread that owns the GL
+  // context (before a render thread takes it over).
+  void configure(sf::Window& window) const;
+  // Called once per loop iteration after the frame has been submitted.
+  void endFrame();
+  // Called after the loop blocked without producing a frame (idle mode), so
+  // the wait is not counted as one long frame.
+  void resume();
+
+  PacingMode getMode() const;
+  bool isIdleMode() const;
+  float getTargetFps() const;
+
+  std::string describe() const;
+  void report(std::ostream& out) const;
+
+  static const char* modeName(PacingMode mode);
+  static bool parseMode(const std::string& name, PacingMode& mode);
+};
+
+#endif  // FRAMEPACER_H
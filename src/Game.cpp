@@ -1,97 +1,268 @@
 #include "Game.h"
+#include "AllocTracker.h"
 #include "Projectile.h"
 #include "Enemy.h"
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <iostream>
 #include <random>
 #include <optional>
+#include <stdexcept>
 #include <string>
 
+namespace {
+// Rasterizes every printable ASCII glyph at the text's size up front. The
+// render thread reads the font's glyph texture while drawing, so the
+// simulation thread must never have to add glyphs to it mid-game.
+void preloadGlyphs(sf::Text &text) {
+  std::string ascii;
+  for (char c = ' '; c <= '~'; c++) {
+    ascii += c;
+  }
+  text.setString(ascii);
+  (void)text.getLocalBounds();
+}
+}  // namespace
+
 void Game::initWindow() {
   this->window =
       new sf::RenderWindow(sf::VideoMode({1920, 1080}), "SpaceShooter");
+  AllocTracker::recordAlloc(AllocCategory::Window, sizeof(sf::RenderWindow));
 }
 
 void Game::initCamera() {
-  camera.setSize({1920.f, 1080.f});
+  // The simulation decides what each player can see from the same size.
+  camera.setSize({Simulation::VIEW_WIDTH, Simulation::VIEW_HEIGHT});
   camera.setCenter(player->getPos());
-  camera.zoom(0.1f);
-  this->window->setView(camera);
+  if (this->window) {
+    this->window->setView(camera);
+  }
 }
 
-Game::~Game() {
+bool Game::isRunning() const {
+  return running && (headless || (this->window && this->window->isOpen()));
+}
+
+void Game::closeWindow() {
+  running = false;
+  // The render thread must give the context back before the window closes.
+  renderThread.reset();
   if (this->window && this->window->isOpen()) {
+    resolutionScaler.releaseGpuResources();
     this->window->close();
   }
+}
 
-  delete this->player;
-  this->player = nullptr;
-  
-  for(Enemy* enemy : enemies) {
-    delete enemy;
-  }
-  enemies.clear();
+Game::~Game() {
+  closeWindow();
 
+  if (this->window) {
+    AllocTracker::recordFree(AllocCategory::Window, sizeof(sf::RenderWindow));
+  }
   delete this->window;
   this->window = nullptr;
+
+  AllocTracker::dump(std::clog);
 }
 
 void Game::run() {
-  while (this->window->isOpen()) {
+  while (isRunning()) {
+    // Idle pacing: nothing moves on a static screen, so sleep until input.
+    if (pacer.isIdleMode() && isGameOver && !sceneDirty) {
+      waitForEvents();
+      continue;
+    }
+
     dt = deltaClock.restart().asSeconds();
+    if (soakTest.has_value()) {
+      dt = SoakTest::FIXED_DT;
+    } else if (scenario.has_value()) {
+      dt = ScenarioRunner::FIXED_DT;
+    }
+    AllocTracker::beginFrame();
 
+    phaseClock.restart();
     this->update();
-    this->render();
+    float updateMs = phaseClock.restart().asSeconds() * 1000.0f;
+    if (!headless) {
+      this->render();
+    }
+    float renderBuildMs = phaseClock.restart().asSeconds() * 1000.0f;
+    sceneDirty = false;
+
+    // Scenarios pin the governor so every run does the same work.
+    if (!scenario.has_value() && governor.recordFrame(updateMs, renderWorkMs)) {
+      applyGovernorKnobs();
+      metrics.governorChanges->add();
+    }
+    recordFrameMetrics(updateMs, renderBuildMs);
+    updateSoakTest();
+    updateScenario();
+    pacer.endFrame();
+    input.beginFrame();
+    frameIndex++;
   }
+
+  pacer.report(std::clog);
+}
+
+void Game::waitForEvents() {
+  // Time out now and then so a window closed behind our back is noticed.
+  if (const std::optional event = this->window->waitEvent(sf::milliseconds(500))) {
+    handleEvent(*event);
+  }
+  // The wait is not a frame: keep it out of dt, pacing and frame-time stats.
+  deltaClock.restart();
+  pacer.resume();
+  frameClock.restart();
 }
 
 void Game::updatePollEvents() {
   while (const std::optional event = this->window->pollEvent()) {
-    if (event->is<sf::Event::Closed>()) {
-      this->window->close();
+    handleEvent(*event);
+  }
+}
+
+void Game::handleEvent(const sf::Event &event) {
+  input.onEvent(event);
+  sceneDirty = true;
+
+  if (event.is<sf::Event::Closed>()) {
+    closeWindow();
+  }
+
+  if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+    if (keyPressed->code == sf::Keyboard::Key::F3) {
+      showDebugOverlay = !showDebugOverlay;
+    } else if (keyPressed->code == sf::Keyboard::Key::F4) {
+      input.setLowLatency(!input.isLowLatency());
     }
-    
-    if (isGameOver) {
-      if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Escape) {
-          this->window->close();
-        } else if (keyPressed->code == sf::Keyboard::Key::R) {
-          resetGame();
-        }
+  }
+  
+  if (isGameOver) {
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+      if (keyPressed->code == sf::Keyboard::Key::Escape) {
+        closeWindow();
+      } else if (keyPressed->code == sf::Keyboard::Key::R) {
+        resetGame();
       }
     }
   }
 }
 
 void Game::render() {
-  this->window->clear();
+  sf::Clock buildClock;
+  sampleLateInput();
+
+  RenderList &list = beginRenderList();
+  list.setInputTimestamp(input.getFrameInputUs());
 
-  this->window->setView(camera);
+  list.setView(camera);
 
-  chunkManager.drawChunks(*this->window);
+  chunkManager.drawChunks(list);
+  chunkManager.drawStarfield(list, &starfieldCache, camera.getCenter());
+  renderWorldEntities(list);
 
   const sf::Sprite& playerSprite = player->getSprite();
-  this->window->draw(playerSprite);
+  list.addSprite(playerSprite);
 
   const std::vector<Projectile*>& projectiles = player->getProjectiles();
   for(const Projectile* projectile : projectiles) {
-    this->window->draw(projectile->getSprite());
+    list.addSprite(projectile->getSprite());
   }
   
-  renderEnemies();
-  renderUI();
-  renderGameOver();
+  renderEnemies(list);
+  renderBullets(list);
+  renderGameOver(list);
+
+  list.beginOverlayPass();
+  renderUI(list);
+
+  float buildMs = buildClock.getElapsedTime().asSeconds() * 1000.0f;
+  submitRenderList();
+  renderWorkMs += buildMs;
+}
+
+RenderList &Game::beginRenderList() {
+  if (renderThread) {
+    return renderThread->acquire();
+  }
+  inlineRenderList.clear();
+  return inlineRenderList;
+}
+
+void Game::submitRenderList() {
+  if (renderThread) {
+    renderThread->submit();
+    lastDrawCalls = renderThread->getLastDrawCalls();
+    renderWorkMs = renderThread->getLastRenderMs();
+    return;
+  }
 
+  sf::Clock drawClock;
+  this->window->clear();
+  lastDrawCalls = resolutionScaler.render(inlineRenderList, *this->window);
+  renderWorkMs = drawClock.getElapsedTime().asSeconds() * 1000.0f;
   this->window->display();
+  input.recordPresented(inlineRenderList.getInputTimestamp());
+}
+
+void Game::sampleLateInput() {
+  if (!input.isLowLatency() || isGameOver || soakTest.has_value() || scenario.has_value()) {
+    return;
+  }
+
+  // The camera has already followed the player this frame, so mapping now
+  // uses the view the frame is drawn with rather than last frame's.
+  sf::Vector2i mousePos = sf::Mouse::getPosition(*this->window);
+  player->lateAim(this->window->mapPixelToCoords(mousePos, camera));
+  player->update();
+  input.markSampled(mousePos);
 }
 
-void Game::renderEnemies() {
-  for(const Enemy* enemy : enemies) {
-    enemy->render(*window);
+void Game::renderEnemies(RenderList &list) {
+  for(const Enemy* enemy : simulation.getEnemies()) {
+    enemy->render(list);
   }
 }
 
+void Game::renderBullets(RenderList &list) {
+  sf::FloatRect visible(camera.getCenter() - camera.getSize() / 2.0f, camera.getSize());
+  simulation.getBullets().addToRenderList(visible, list);
+}
+
+PlayerInput Game::sampleDeviceInput() const {
+  PlayerInput sampled;
+
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+    sampled.move.x = -1.f;
+  } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    sampled.move.x = 1.f;
+  }
+
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+    sampled.move.y = -1.f;
+  } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+    sampled.move.y = 1.f;
+  }
+
+  sf::Vector2i mousePos = sf::Mouse::getPosition(*this->window);
+  sampled.aimTarget = this->window->mapPixelToCoords(mousePos, camera);
+  sampled.fire = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
+  return sampled;
+}
+
 void Game::update() {
-  this->updatePollEvents();
+  if (this->window) {
+    this->updatePollEvents();
+  }
+
+  // A scenario keeps its load going through player deaths.
+  if (scenario.has_value() && player->isDead()) {
+    scenario->recordDeath();
+    player->heal(player->getMaxHealth());
+  }
   
   if(player->isDead() && !isGameOver) {
     gameOver();
@@ -101,101 +272,98 @@ void Game::update() {
   if(isGameOver) {
     return;
   }
+  sceneDirty = true;
 
-  player->handleInput(dt);
-  player->update();
+  const std::vector<Enemy*> &enemies = simulation.getEnemies();
+  if (soakTest.has_value()) {
+    simulation.setInput(localPlayerId, soakTest->nextInput(*player, enemies));
+  } else if (scenario.has_value()) {
+    simulation.setInput(localPlayerId, scenario->nextInput(*player, enemies));
+  } else {
+    simulation.setInput(localPlayerId, sampleDeviceInput());
+  }
+
+  if (scenario.has_value()) {
+    // Waves are the whole load, so they bypass the governor's enemy cap.
+    scenario->spawnDueWaves(
+        player->getPos(), [this](sf::Vector2f position, const ScenarioArchetype &archetype) {
+          simulation.addEnemy(position, archetype.sprite,
+                              simulation.getBulletPatterns().find(archetype.pattern));
+          metrics.enemiesSpawned->add();
+        });
+  }
+
+  const SimulationStepStats &stepStats = simulation.step(dt);
+
+  sf::Clock streamClock;
   camera.setCenter(player->getPos());
   chunkManager.UpdateChunks(player->getPos());
-  
-  enemySpawnTimer += dt;
-  if(enemySpawnTimer >= enemySpawnInterval) {
-    spawnEnemy();
-    enemySpawnTimer = 0.0f;
-  }
-  
-  updateEnemies();
+  metrics.playerPhase->record(stepStats.playerMicros +
+                              streamClock.getElapsedTime().asMicroseconds());
+  metrics.enemyPhase->record(stepStats.enemyMicros);
+  metrics.collisionPhase->record(stepStats.collisionMicros);
+  metrics.enemiesSpawned->add(stepStats.enemiesSpawned);
+  metrics.enemiesKilled->add(stepStats.enemiesKilled);
   updateUI();
-  checkCollisions();
 }
 
-void Game::spawnEnemy() {
-  float angle = angleDist(randomEngine);
-  float distance = distanceDist(randomEngine);
-  
-  sf::Vector2f playerPos = player->getPos();
-  sf::Vector2f enemyPos;
-  enemyPos.x = playerPos.x + std::cos(angle) * distance;
-  enemyPos.y = playerPos.y + std::sin(angle) * distance;
-  
-  int spriteType = spriteDist(randomEngine);
-  enemies.push_back(new Enemy(enemyPos, window, spriteType));
-}
-
-void Game::updateEnemies() {
-  for(size_t i = 0; i < enemies.size(); i++) {
-    enemies[i]->update(dt, *player, camera);
-    
-    if(enemies[i]->isDead()) {
-      delete enemies[i];
-      enemies.erase(enemies.begin() + i);
-      i--;
-    }
+void Game::loadWorldFile(const std::string &path) {
+  if (path.empty() || !std::filesystem::exists(path)) {
+    std::clog << "[world] no world file at '" << path
+              << "', using procedural chunks only" << std::endl;
+    return;
   }
+  worldFile.emplace(path);
+  chunkManager.setWorldFile(&worldFile.value());
+  simulation.setWorldFile(&worldFile.value());
+  std::clog << "[world] mapped " << path << ": " << worldFile->getChunkCount()
+            << " chunks, " << worldFile->getEntityCount() << " entities" << std::endl;
 }
 
-void Game::checkCollisions() {
-  const std::vector<Projectile*>& playerProjectiles = player->getProjectiles();
-  for(size_t projIndex = 0; projIndex < playerProjectiles.size(); projIndex++) {
-    sf::FloatRect projectileBounds = playerProjectiles[projIndex]->getSprite().getGlobalBounds();
-    
-    for(size_t enemyIndex = 0; enemyIndex < enemies.size(); enemyIndex++) {
-      sf::FloatRect enemyBounds = enemies[enemyIndex]->getGlobalBounds();
-      
-      if (projectileBounds.position.x < enemyBounds.position.x + enemyBounds.size.x &&
-          projectileBounds.position.x + projectileBounds.size.x > enemyBounds.position.x &&
-          projectileBounds.position.y < enemyBounds.position.y + enemyBounds.size.y &&
-          projectileBounds.position.y + projectileBounds.size.y > enemyBounds.position.y) {
-        
-        enemies[enemyIndex]->takeDamage(25.0f);
-        
-        if (enemies[enemyIndex]->isDead()) {
-          enemiesKilled++;
-        }
-        
-        break;
+void Game::renderWorldEntities(RenderList &list) {
+  const int segments = 16;
+  std::vector<sf::Vertex> &vertices = list.addVertices(sf::PrimitiveType::Triangles);
+
+  for (const Chunk &chunk : chunkManager.getLoadedChunks()) {
+    sf::Vector2f origin(static_cast<float>(chunk.position.x * CHUNK_SIZE),
+                        static_cast<float>(chunk.position.y * CHUNK_SIZE));
+    for (std::uint32_t i = 0; i < chunk.entities.count; i++) {
+      const WorldEntity &entity = chunk.entities.entities[i];
+      sf::Color color;
+      switch (static_cast<WorldEntityType>(entity.type)) {
+        case WorldEntityType::Hazard:
+          color = sf::Color(255, 60, 40, 90);
+          break;
+        case WorldEntityType::Spawner:
+          color = sf::Color(180, 80, 255, 140);
+          break;
+        case WorldEntityType::Pickup:
+          if (simulation.isPickupCollected(chunk.entities.firstIndex + i)) {
+            continue;
+          }
+          color = sf::Color(80, 255, 120, 200);
+          break;
+        default:
+          continue;
       }
-    }
-  }
-  
-  for(Enemy* enemy : enemies) {
-    const std::vector<Projectile*>& enemyProjectiles = enemy->getProjectiles();
-    sf::FloatRect playerBounds = player->getGlobalBounds();
-    
-    for(size_t projIndex = 0; projIndex < enemyProjectiles.size(); projIndex++) {
-      sf::FloatRect projectileBounds = enemyProjectiles[projIndex]->getSprite().getGlobalBounds();
-      
-      if (projectileBounds.position.x < playerBounds.position.x + playerBounds.size.x &&
-          projectileBounds.position.x + projectileBounds.size.x > playerBounds.position.x &&
-          projectileBounds.position.y < playerBounds.position.y + playerBounds.size.y &&
-          projectileBounds.position.y + projectileBounds.size.y > playerBounds.position.y) {
-        
-        player->takeDamage(enemy->getDamage());
-        
-        enemy->removeProjectile(projIndex);
-        break;
+
+      sf::Vector2f center = origin + sf::Vector2f(entity.x, entity.y);
+      for (int s = 0; s < segments; s++) {
+        float a0 = 2.0f * 3.14159f * s / segments;
+        float a1 = 2.0f * 3.14159f * (s + 1) / segments;
+        vertices.push_back({center, color, {}});
+        vertices.push_back(
+            {center + sf::Vector2f(std::cos(a0), std::sin(a0)) * entity.radius, color, {}});
+        vertices.push_back(
+            {center + sf::Vector2f(std::cos(a1), std::sin(a1)) * entity.radius, color, {}});
       }
     }
   }
-  
-  for(Enemy* enemy : enemies) {
-    if (enemy->checkCollisionWithPlayer(*player) && player->canTakeCollisionDamage()) {
-      player->takeDamage(enemy->getDamage());
-    }
-  }
 }
 
 void Game::gameOver() {
   isGameOver = true;
+  sceneDirty = true;
 }
 
 void Game::initGameOverUI() {
@@ -208,24 +376,26 @@ void Game::initGameOverUI() {
   gameOverText = sf::Text(gameOverFont.value());
   restartText = sf::Text(gameOverFont.value());
   
-  gameOverText->setString("GAME OVER");
   gameOverText->setCharacterSize(24);
+  preloadGlyphs(gameOverText.value());
+  gameOverText->setString("GAME OVER");
   gameOverText->setFillColor(sf::Color::Red);
   
-  restartText->setString("Press R to Restart or ESC to Quit");
   restartText->setCharacterSize(12);
+  preloadGlyphs(restartText.value());
+  restartText->setString("Press R to Restart or ESC to Quit");
   restartText->setFillColor(sf::Color::White);
 }
 
 void Game::handleGameOverInput() {
   while (std::optional<sf::Event> event = window->pollEvent()) {
     if (event->is<sf::Event::Closed>()) {
-      window->close();
+      closeWindow();
     }
     
     if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
       if (keyPressed->code == sf::Keyboard::Key::Escape) {
-        window->close();
+        closeWindow();
       } else if (keyPressed->code == sf::Keyboard::Key::R) {
         resetGame();
       }
@@ -234,24 +404,16 @@ void Game::handleGameOverInput() {
 }
 
 void Game::resetGame() {
-  delete player;
-  player = new Player({400.f, 300.f}, this->window);
-  
-  for(Enemy* enemy : enemies) {
-    delete enemy;
-  }
-  enemies.clear();
-  
-  enemySpawnTimer = 0.0f;
+  simulation.reset({400.f, 300.f});
+  player = simulation.getPlayer(localPlayerId);
   deltaClock.restart();
   
   isGameOver = false;
-  enemiesKilled = 0;
   
   camera.setCenter(player->getPos());
 }
 
-void Game::renderGameOver() {
+void Game::renderGameOver(RenderList &list) {
   if (!isGameOver || !gameOverText.has_value() || !restartText.has_value()) {
     return;
   }
@@ -270,8 +432,8 @@ void Game::renderGameOver() {
     viewCenter.y + 50.0f
   ));
   
-  window->draw(gameOverText.value());
-  window->draw(restartText.value());
+  list.addText(gameOverText.value());
+  list.addText(restartText.value());
 }
 
 void Game::initUI() {
@@ -282,12 +444,14 @@ void Game::initUI() {
   }
   
   counterText = sf::Text(uiFont.value());
-  counterText->setString("Score: 0");
   counterText->setCharacterSize(20);
+  preloadGlyphs(counterText.value());
+  counterText->setString("Score: 0");
   counterText->setFillColor(sf::Color::White);
   
   healthText = sf::Text(uiFont.value());
   healthText->setCharacterSize(16);
+  preloadGlyphs(healthText.value());
   healthText->setFillColor(sf::Color::White);
   
   healthBarBackground = sf::RectangleShape();
@@ -299,6 +463,11 @@ void Game::initUI() {
   healthBarForeground = sf::RectangleShape();
   healthBarForeground->setSize(sf::Vector2f(150.0f, 15.0f));
   healthBarForeground->setFillColor(sf::Color::Green);
+
+  debugText = sf::Text(uiFont.value());
+  debugText->setCharacterSize(14);
+  preloadGlyphs(debugText.value());
+  debugText->setFillColor(sf::Color::Yellow);
 }
 
 void Game::updateUI() {
@@ -307,7 +476,8 @@ void Game::updateUI() {
     return;
   }
   
-  counterText->setString("Score: " + std::to_string(enemiesKilled));
+  counterText->setString("Score: " +
+                         std::to_string(simulation.getEnemiesKilled(localPlayerId)));
   
   float currentHealth = player->getHealth();
   float maxHealth = player->getMaxHealth();
@@ -327,14 +497,14 @@ void Game::updateUI() {
   }
 }
 
-void Game::renderUI() {
+void Game::renderUI(RenderList &list) {
   if (!counterText.has_value() || !healthText.has_value() || 
       !healthBarBackground.has_value() || !healthBarForeground.has_value()) {
     return;
   }
   
   sf::View defaultView = window->getDefaultView();
-  window->setView(defaultView);
+  list.setView(defaultView);
   
   sf::Vector2f screenSize = defaultView.getSize();
   
@@ -352,33 +522,221 @@ void Game::renderUI() {
   healthBarBackground->setPosition(sf::Vector2f(rightX, bottomY));
   healthBarForeground->setPosition(sf::Vector2f(rightX, bottomY));
   
-  window->draw(counterText.value());
-  window->draw(healthText.value());
-  window->draw(healthBarBackground.value());
-  window->draw(healthBarForeground.value());
+  list.addText(counterText.value());
+  list.addText(healthText.value());
+  list.addShape(healthBarBackground.value());
+  list.addShape(healthBarForeground.value());
+
+  renderDebugOverlay(list);
   
-  window->setView(camera);
+  list.setView(camera);
+}
+
+void Game::applyGovernorKnobs() {
+  const FrameBudgetKnobs& knobs = governor.getKnobs();
+  chunkManager.setLoadDistance(knobs.chunkLoadDistance);
+  resolutionScaler.setMaxScaleCap(knobs.renderScale);
+  simulation.setKnobs(knobs);
+}
+
+void Game::updateSoakTest() {
+  if (!soakTest.has_value()) {
+    return;
+  }
+
+  // Keep replaying after a death so the run covers the full duration.
+  if (isGameOver) {
+    resetGame();
+  }
+
+  soakTest->advance(dt);
+  if (soakTest->isFinished()) {
+    exitCode = soakTest->evaluate(std::clog) ? 0 : 1;
+    soakTest.reset();
+    closeWindow();
+  }
+}
+
+void Game::startScenario(const std::string &nameOrPath, std::uint32_t seedOverride) {
+  ScenarioDefinition definition =
+      ScenarioDefinition::load(ScenarioDefinition::resolvePath(nameOrPath));
+  for (const ScenarioArchetype &archetype : definition.archetypes) {
+    if (!archetype.pattern.empty() && !simulation.getBulletPatterns().find(archetype.pattern)) {
+      throw std::runtime_error("Scenario archetype '" + archetype.name +
+                               "' uses unknown bullet pattern '" + archetype.pattern + "'");
+    }
+  }
+  if (seedOverride != 0) {
+    definition.seed = seedOverride;
+  }
+  simulation.seed(definition.seed);
+  simulation.setRandomSpawning(false);
+
+  std::clog << "[scenario] running " << definition.name << " for " << definition.duration
+            << " s with seed " << definition.seed << (headless ? " (headless)" : "")
+            << std::endl;
+  scenario.emplace(std::move(definition), player->getPos());
+  scenarioClock.restart();
+}
+
+void Game::updateScenario() {
+  if (!scenario.has_value()) {
+    return;
+  }
+
+  scenario->advance(dt, simulation.getEnemies().size(), simulation.getBullets().size());
+  if (scenario->isFinished()) {
+    scenario->report(std::clog, scenarioClock.getElapsedTime().asSeconds(), frameIndex + 1);
+    MetricHistogram::Summary frame = metrics.frameTime->summarize();
+    MetricHistogram::Summary update = metrics.updateTime->summarize();
+    std::clog << "[scenario] frame ms p50 " << frame.p50 * 1000.0 << "  p99 "
+              << frame.p99 * 1000.0 << "  p99.9 " << frame.p999 * 1000.0
+              << " | update ms p50 " << update.p50 * 1000.0 << "  p99 "
+              << update.p99 * 1000.0 << "  p99.9 " << update.p999 * 1000.0 << std::endl;
+    scenario.reset();
+    closeWindow();
+  }
 }
 
-Game::Game() {
-  this->initWindow();
+void Game::recordFrameMetrics(float updateMs, float renderBuildMs) {
+  metrics.frames->add();
+  metrics.frameTime->record(frameClock.restart().asMicroseconds());
+  metrics.updateTime->record(static_cast<std::int64_t>(updateMs * 1000.0f));
+  metrics.renderBuild->record(static_cast<std::int64_t>(renderBuildMs * 1000.0f));
+  metrics.renderWork->record(static_cast<std::int64_t>(renderWorkMs * 1000.0f));
+
+  size_t projectileCount = player->getProjectiles().size() + simulation.getBullets().size();
+  metrics.enemies->record(static_cast<std::int64_t>(simulation.getEnemies().size()));
+  metrics.projectiles->record(static_cast<std::int64_t>(projectileCount));
+  metrics.chunks->record(static_cast<std::int64_t>(chunkManager.getLoadedChunkCount()));
+  metrics.drawCalls->record(static_cast<std::int64_t>(lastDrawCalls));
+  metrics.frameAllocations->record(
+      static_cast<std::int64_t>(AllocTracker::getLastFrameAllocations()));
+  metrics.liveBytes->set(AllocTracker::getTotalLiveBytes());
+  metrics.governorLevel->set(governor.getLevel());
+}
+
+GameMetrics::GameMetrics(MetricsRegistry &registry)
+    : frames(registry.addCounter("spaceshooter_frames_total", "Frames simulated")),
+      enemiesSpawned(registry.addCounter("spaceshooter_enemies_spawned_total",
+                                         "Enemies spawned")),
+      enemiesKilled(registry.addCounter("spaceshooter_enemies_killed_total",
+                                        "Enemies killed by the player")),
+      governorChanges(registry.addCounter("spaceshooter_governor_changes_total",
+                                          "Frame budget governor level changes")),
+      governorLevel(registry.addGauge("spaceshooter_governor_level",
+                                      "Current frame budget governor level")),
+      liveBytes(registry.addGauge("spaceshooter_live_bytes",
+                                  "Bytes held by tracked game objects")),
+      frameTime(registry.addHistogram("spaceshooter_frame_time_seconds",
+                                      "Wall time between frame starts", 1e-6)),
+      updateTime(registry.addHistogram("spaceshooter_update_seconds",
+                                       "Whole update phase", 1e-6)),
+      playerPhase(registry.addHistogram("spaceshooter_update_player_seconds",
+                                        "Player input, projectiles and chunk streaming",
+                                        1e-6)),
+      enemyPhase(registry.addHistogram("spaceshooter_update_enemies_seconds",
+                                       "Enemy spawning and AI", 1e-6)),
+      collisionPhase(registry.addHistogram("spaceshooter_update_collisions_seconds",
+                                           "Collision detection and resolution", 1e-6)),
+      renderBuild(registry.addHistogram("spaceshooter_render_build_seconds",
+                                        "Recording the render list", 1e-6)),
+      renderWork(registry.addHistogram("spaceshooter_render_work_seconds",
+                                       "Drawing the render list, excluding present",
+                                       1e-6)),
+      enemies(registry.addHistogram("spaceshooter_enemies", "Live enemies per frame")),
+      projectiles(registry.addHistogram("spaceshooter_projectiles",
+                                        "Live player shots and enemy bullets per frame")),
+      chunks(registry.addHistogram("spaceshooter_chunks", "Loaded chunks per frame")),
+      drawCalls(registry.addHistogram("spaceshooter_draw_calls", "Draw calls per frame")),
+      frameAllocations(registry.addHistogram("spaceshooter_frame_allocations",
+                                             "Tracked heap allocations per frame")) {}
+
+void Game::renderDebugOverlay(RenderList &list) {
+  if (!showDebugOverlay || !debugText.has_value()) {
+    return;
+  }
+
+  const BulletPool &bullets = simulation.getBullets();
+  debugText->setString(governor.describe() +
+                       "\nEnemies " + std::to_string(simulation.getEnemies().size()) +
+                       "  Chunks " + std::to_string(chunkManager.getLoadedChunkCount()) +
+                       "  Flock max/cell " +
+                       std::to_string(simulation.getFlock().getMaxCellOccupancy()) +
+                       "  Bullets " + std::to_string(bullets.size()) + " / " +
+                       std::to_string(bullets.getCapacity()) +
+                       "\n" + AllocTracker::describe() +
+                       "\nDraw calls " + std::to_string(lastDrawCalls) +
+                       (renderThread ? "  Render thread " +
+                                           std::to_string(renderThread->getLastRenderMs()) + " ms"
+                                     : std::string("  Render inline")) +
+                       "\n" + pacer.describe() +
+                       "\n" + resolutionScaler.describe() +
+                       "\n" + starfieldCache.describe() +
+                       "\nLow latency " + (input.isLowLatency() ? "on" : "off") +
+                       " (F4)  " + input.getHistogram().describe());
+  debugText->setPosition(sf::Vector2f(20.0f, 20.0f));
+  list.addText(debugText.value());
+}
+
+Game::Game(const GameOptions& options)
+    : headless(options.headless),
+      running(true),
+      resolutionScaler(options.minRenderScale, options.maxRenderScale),
+      pacer(options.headless ? PacingMode::Unlimited : options.pacing, options.targetFps),
+      metrics(metricsRegistry),
+      simulation(0, &threadPool) {
+  this->window = nullptr;
+  if (!headless) {
+    this->initWindow();
+    pacer.configure(*this->window);
+  }
+  exitCode = 0;
 
   dt = 0.0f;
   deltaClock.restart();
 
-  player = new Player({400.f, 300.f}, this->window);
+  localPlayerId = simulation.addPlayer({400.f, 300.f});
+  player = simulation.getPlayer(localPlayerId);
   this->initCamera();
   
   isGameOver = false;
   initGameOverUI();
   
-  enemiesKilled = 0;
+  frameIndex = 0;
+  showDebugOverlay = false;
   initUI();
+  applyGovernorKnobs();
+
+  lastDrawCalls = 0;
+  renderWorkMs = 0.0f;
+  sceneDirty = true;
+  input.setLowLatency(options.lowLatency);
+  if (options.renderThread && !headless) {
+    renderThread = std::make_unique<RenderThread>(
+        *this->window, [this](const RenderList &presented) {
+          input.recordPresented(presented.getInputTimestamp());
+        },
+        &resolutionScaler);
+  }
   
-  enemySpawnTimer = 0.0f;
-  enemySpawnInterval = 1.0f;
-  randomEngine.seed(std::random_device{}());
-  angleDist = std::uniform_real_distribution<float>(0.0f, 2.0f * 3.14159f);
-  distanceDist = std::uniform_real_distribution<float>(200.0f, 300.0f);
-  spriteDist = std::uniform_int_distribution<int>(0, 2);
+  std::uint32_t seed = options.seed != 0 ? options.seed : std::random_device{}();
+  simulation.seed(seed);
+
+  if (options.soakSeconds > 0.0f) {
+    soakTest.emplace(options.soakSeconds, seed);
+    std::clog << "[soak] running " << options.soakSeconds << " s with seed "
+              << seed << std::endl;
+  }
+  if (!options.metricsDir.empty()) {
+    metricsExporter.emplace(metricsRegistry, options.metricsDir, options.metricsInterval);
+  }
+  frameClock.restart();
+  simulation.setBulletPatterns(BulletPatternLibrary::load("patterns.txt"));
+  loadWorldFile(options.worldPath);
+
+  if (!options.scenarioPath.empty()) {
+    startScenario(options.scenarioPath, options.seed);
+  }
+  frameClock.restart();
 }
@@ -2,20 +2,87 @@
 #define GAME_H
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/View.hpp>
-#include <random>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
-#include "Enemy.h"
+#include "FrameGovernor.h"
+#include "FramePacer.h"
+#include "InputSystem.h"
+#include "Metrics.h"
 #include "Player.h"
+#include "RenderList.h"
+#include "RenderThread.h"
+#include "ResolutionScaler.h"
+#include "Scenario.h"
+#include "Simulation.h"
+#include "SoakTest.h"
+#include "Starfield.h"
+#include "ThreadPool.h"
+#include "WorldFile.h"
 #include "chunk.h"
 
+struct GameOptions {
+  float soakSeconds = 0.0f;  // > 0 runs the allocation soak test
+  std::uint32_t seed = 0;    // 0 picks a random seed
+  bool renderThread = true;  // draw on a dedicated thread
+  bool lowLatency = false;   // late mouse sampling before each frame
+  PacingMode pacing = PacingMode::VSync;
+  float targetFps = 60.0f;   // used by PacingMode::Limiter
+  float minRenderScale = 0.5f;  // world pass resolution range; 1.0 = native
+  float maxRenderScale = 1.0f;
+  std::string metricsDir;        // empty disables metrics export
+  float metricsInterval = 5.0f;  // seconds between exports
+  std::string worldPath = "world.bin";  // packed authored content, optional
+  std::string scenarioPath;      // name or file of a scripted test level
+  bool headless = false;         // no window or drawing; needs a scenario or soak
+};
+
+// Handles to the session metrics recorded by the game loop.
+struct GameMetrics {
+  MetricCounter *frames;
+  MetricCounter *enemiesSpawned;
+  MetricCounter *enemiesKilled;
+  MetricCounter *governorChanges;
+  MetricGauge *governorLevel;
+  MetricGauge *liveBytes;
+  MetricHistogram *frameTime;
+  MetricHistogram *updateTime;
+  MetricHistogram *playerPhase;
+  MetricHistogram *enemyPhase;
+  MetricHistogram *collisionPhase;
+  MetricHistogram *renderBuild;
+  MetricHistogram *renderWork;
+  MetricHistogram *enemies;
+  MetricHistogram *projectiles;
+  MetricHistogram *chunks;
+  MetricHistogram *drawCalls;
+  MetricHistogram *frameAllocations;
+
+  explicit GameMetrics(MetricsRegistry &registry);
+};
+
 class Game {
  private:
   // variables
   sf::RenderWindow *window;
+  bool headless;
+  bool running;
+  StarfieldCache starfieldCache;  // drawn from the render side only
+  std::unique_ptr<RenderThread> renderThread;
+  RenderList inlineRenderList;
+  ResolutionScaler resolutionScaler;
+  size_t lastDrawCalls;
+  float renderWorkMs;
+  FramePacer pacer;
+  bool sceneDirty;
+  std::optional<WorldFile> worldFile;
   ChunkManager chunkManager;
   sf::View camera;
-  Player *player;
+  Player *player;  // the local player, owned by the simulation
+  InputSystem input;
   sf::Clock deltaClock;
   float dt;
   bool isGameOver;
@@ -29,33 +96,64 @@ class Game {
   std::optional<sf::Text> healthText;
   std::optional<sf::RectangleShape> healthBarBackground;
   std::optional<sf::RectangleShape> healthBarForeground;
-  int enemiesKilled;
 
-  // Enemy management
-  std::vector<Enemy *> enemies;
-  float enemySpawnTimer;
-  float enemySpawnInterval;
-  std::mt19937 randomEngine;
-  std::uniform_real_distribution<float> angleDist;
-  std::uniform_real_distribution<float> distanceDist;
-  std::uniform_int_distribution<int> spriteDist;
+  // Frame budget governor and debug overlay
+  FrameGovernor governor;
+  sf::Clock phaseClock;
+  unsigned long frameIndex;
+  bool showDebugOverlay;
+  std::optional<sf::Text> debugText;
+
+  // Session metrics; the exporter writes them out in the background
+  MetricsRegistry metricsRegistry;
+  GameMetrics metrics;
+  std::optional<MetricsExporter> metricsExporter;
+  sf::Clock frameClock;
+
+  // Soak test mode
+  std::optional<SoakTest> soakTest;
+  int exitCode;
+
+  // Scripted scenario mode
+  std::optional<ScenarioRunner> scenario;
+  sf::Clock scenarioClock;
+
+  // Game state and rules, shared with the loopback server; the thread pool
+  // runs its collision detection
+  ThreadPool threadPool;
+  Simulation simulation;
+  std::uint32_t localPlayerId;
 
   void initWindow();
   void initCamera();
-  void spawnEnemy();
-  void updateEnemies();
-  void renderEnemies();
-  void checkCollisions();
+  void loadWorldFile(const std::string &path);
+  void renderWorldEntities(RenderList &list);
+  void renderEnemies(RenderList &list);
+  void renderBullets(RenderList &list);
+  PlayerInput sampleDeviceInput() const;
   void resetGame();
   void handleGameOverInput();
-  void renderGameOver();
+  void renderGameOver(RenderList &list);
   void initGameOverUI();
   void initUI();
   void updateUI();
-  void renderUI();
+  void renderUI(RenderList &list);
+  void applyGovernorKnobs();
+  void renderDebugOverlay(RenderList &list);
+  RenderList &beginRenderList();
+  void submitRenderList();
+  void closeWindow();
+  void handleEvent(const sf::Event &event);
+  void waitForEvents();
+  void sampleLateInput();
+  void updateSoakTest();
+  void startScenario(const std::string &nameOrPath, std::uint32_t seedOverride);
+  void updateScenario();
+  bool isRunning() const;
+  void recordFrameMetrics(float updateMs, float renderBuildMs);
 
  public:
-  Game();
+  explicit Game(const GameOptions& options = GameOptions());
   ~Game();
 
   void updatePollEvents();
@@ -63,6 +161,7 @@ class Game {
   void render();
   void run();
   void gameOver();
+  int getExitCode() const { return exitCode; }
 
   const Player *getPlayer() { return player; }
 };
@@ -0,0 +1,124 @@
+#include "GpuTimer.h"
+
+namespace {
+#if defined(_WIN32)
+#define GPU_TIMER_APIENTRY __stdcall
+#else
+#define GPU_TIMER_APIENTRY
+#endif
+
+// From glext.h; SFML does not expose a GL loader, so the handful of entry
+// points needed here are resolved through sf::Context::getFunction.
+constexpr unsigned int GL_TIME_ELAPSED = 0x88BF;
+constexpr unsigned int GL_QUERY_RESULT = 0x8866;
+constexpr unsigned int GL_QUERY_RESULT_AVAILABLE = 0x8867;
+
+using GenQueriesFn = void(GPU_TIMER_APIENTRY*)(int, unsigned int*);
+using DeleteQueriesFn = void(GPU_TIMER_APIENTRY*)(int, const unsigned int*);
+using BeginQueryFn = void(GPU_TIMER_APIENTRY*)(unsigned int, unsigned int);
+using EndQueryFn = void(GPU_TIMER_APIENTRY*)(unsigned int);
+using GetQueryObjectivFn = void(GPU_TIMER_APIENTRY*)(unsigned int, unsigned int, int*);
+using GetQueryObjectui64vFn = void(GPU_TIMER_APIENTRY*)(unsigned int, unsigned int,
+                                                        std::uint64_t*);
+using FinishFn = void(GPU_TIMER_APIENTRY*)();
+
+struct TimerFunctions {
+  GenQueriesFn genQueries = nullptr;
+  DeleteQueriesFn deleteQueries = nullptr;
+  BeginQueryFn beginQuery = nullptr;
+  EndQueryFn endQuery = nullptr;
+  GetQueryObjectivFn getQueryObjectiv = nullptr;
+  GetQueryObjectui64vFn getQueryObjectui64v = nullptr;
+  FinishFn finish = nullptr;
+
+  bool complete() const {
+    return genQueries && deleteQueries && beginQuery && endQuery && getQueryObjectiv &&
+           getQueryObjectui64v;
+  }
+};
+
+template <typename Fn>
+Fn load(const char* name) {
+  return reinterpret_cast<Fn>(sf::Context::getFunction(name));
+}
+
+// Resolved on first use, which always happens with a context active.
+const TimerFunctions& functions() {
+  static const TimerFunctions loaded = []() {
+    TimerFunctions fns;
+    fns.genQueries = load<GenQueriesFn>("glGenQueries");
+    fns.deleteQueries = load<DeleteQueriesFn>("glDeleteQueries");
+    fns.beginQuery = load<BeginQueryFn>("glBeginQuery");
+    fns.endQuery = load<EndQueryFn>("glEndQuery");
+    fns.getQueryObjectiv = load<GetQueryObjectivFn>("glGetQueryObjectiv");
+    fns.getQueryObjectui64v = load<GetQueryObjectui64vFn>("glGetQueryObjectui64v");
+    if (!fns.getQueryObjectui64v) {
+      fns.getQueryObjectui64v = load<GetQueryObjectui64vFn>("glGetQueryObjectui64vEXT");
+    }
+    fns.finish = load<FinishFn>("glFinish");
+    return fns;
+  }();
+  return loaded;
+}
+}  // namespace
+
+GpuTimer::GpuTimer(const sf::ContextSettings& settings)
+    : queries{}, issued(0), completed(0), timing(false), available(false) {
+  bool core33 = settings.majorVersion > 3 ||
+                (settings.majorVersion == 3 && settings.minorVersion >= 3);
+  bool supported = core33 || sf::Context::isExtensionAvailable("GL_ARB_timer_query") ||
+                   sf::Context::isExtensionAvailable("GL_EXT_timer_query");
+  if (supported && functions().complete()) {
+    functions().genQueries(static_cast<int>(QUERY_COUNT), queries);
+    available = true;
+  }
+}
+
+GpuTimer::~GpuTimer() {
+  if (available) {
+    functions().deleteQueries(static_cast<int>(QUERY_COUNT), queries);
+  }
+}
+
+bool GpuTimer::isAvailable() const { return available; }
+
+void GpuTimer::begin() {
+  if (!available || timing || issued - completed >= QUERY_COUNT) {
+    return;
+  }
+  functions().beginQuery(GL_TIME_ELAPSED, queries[issued % QUERY_COUNT]);
+  timing = true;
+}
+
+void GpuTimer::end() {
+  if (!timing) {
+    return;
+  }
+  functions().endQuery(GL_TIME_ELAPSED);
+  timing = false;
+  issued++;
+}
+
+bool GpuTimer::collect(float& gpuMs) {
+  bool collected = false;
+  while (completed < issued) {
+    unsigned int query = queries[completed % QUERY_COUNT];
+    int ready = 0;
+    functions().getQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &ready);
+    if (!ready) {
+      break;
+    }
+    std::uint64_t nanoseconds = 0;
+    functions().getQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+    gpuMs = static_cast<float>(nanoseconds / 1.0e6);
+    completed++;
+    collected = true;
+  }
+  return collected;
+}
+
+void GpuTimer::finish() {
+  if (functions().finish) {
+    functions().finish();
+  }
+}
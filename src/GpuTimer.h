@@ -0,0 +1,43 @@
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+#include <SFML/Window.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// GPU-side duration of a span of GL commands, measured with GL_TIME_ELAPSED
+// timer queries. Results arrive a frame or two late, so queries are kept in
+// a small ring and collect() returns the newest one that has finished.
+//
+// Create, use and destroy it with the same GL context active. When the
+// context lacks timer queries, isAvailable() is false and every call is a
+// no-op; finish() is the fallback for measuring GPU work from the CPU.
+class GpuTimer {
+ private:
+  static constexpr size_t QUERY_COUNT = 4;
+
+  unsigned int queries[QUERY_COUNT];
+  std::uint64_t issued;     // queries begun so far
+  std::uint64_t completed;  // queries read back so far
+  bool timing;
+  bool available;
+
+ public:
+  explicit GpuTimer(const sf::ContextSettings& settings);
+  ~GpuTimer();
+  GpuTimer(const GpuTimer&) = delete;
+  GpuTimer& operator=(const GpuTimer&) = delete;
+
+  bool isAvailable() const;
+  // Bracket the commands to time. begin() skips the frame when every query
+  // in the ring is still waiting on the GPU.
+  void begin();
+  void end();
+  // Newest finished measurement in milliseconds. Returns false when nothing
+  // finished since the last call.
+  bool collect(float& gpuMs);
+
+  // Blocks until the GPU has executed everything submitted so far.
+  static void finish();
+};
+
+#endif  // GPUTIMER_H
@@ -0,0 +1,51 @@
+#include "InputSystem.h"
+
+InputSystem::InputSystem()
+    : frameInputUs(-1), lowLatency(false), hasSampledPointer(false) {}
+
+void InputSystem::beginFrame() { frameInputUs = -1; }
+
+void InputSystem::onEvent(const sf::Event& event) {
+  if (!event.is<sf::Event::KeyPressed>() && !event.is<sf::Event::KeyReleased>() &&
+      !event.is<sf::Event::MouseMoved>() &&
+      !event.is<sf::Event::MouseButtonPressed>() &&
+      !event.is<sf::Event::MouseButtonReleased>()) {
+    return;
+  }
+  if (frameInputUs < 0) {
+    frameInputUs = nowUs();
+  }
+}
+
+void InputSystem::markSampled(sf::Vector2i pointer) {
+  bool moved = !hasSampledPointer || pointer != sampledPointer;
+  hasSampledPointer = true;
+  sampledPointer = pointer;
+  if (moved && frameInputUs < 0) {
+    frameInputUs = nowUs();
+  }
+}
+
+std::int64_t InputSystem::nowUs() const {
+  return clock.getElapsedTime().asMicroseconds();
+}
+
+std::int64_t InputSystem::getFrameInputUs() const { return frameInputUs; }
+
+void InputSystem::recordPresented(std::int64_t inputUs) {
+  if (inputUs < 0) {
+    return;
+  }
+  histogram.record(nowUs() - inputUs);
+}
+
+bool InputSystem::isLowLatency() const { return lowLatency; }
+
+void InputSystem::setLowLatency(bool enabled) {
+  lowLatency = enabled;
+  histogram.reset();
+}
+
+const LatencyHistogram& InputSystem::getHistogram() const { return histogram; }
+
+void InputSystem::resetHistogram() { histogram.reset(); }
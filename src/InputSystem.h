@@ -0,0 +1,46 @@
+#ifndef INPUTSYSTEM_H
+#define INPUTSYSTEM_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+#include "LatencyHistogram.h"
+
+// Timestamps input events as they are polled and measures how long it takes
+// until a frame that consumed them reaches display().
+class InputSystem {
+ private:
+  sf::Clock clock;
+  std::int64_t frameInputUs;  // oldest input polled this frame, -1 for none
+  bool lowLatency;
+  bool hasSampledPointer;
+  sf::Vector2i sampledPointer;  // pointer position at the last late sample
+  LatencyHistogram histogram;
+
+ public:
+  InputSystem();
+
+  // Starts collecting input for the next frame. Called right after a frame
+  // is submitted, so events seen while the loop blocks still count.
+  void beginFrame();
+  void onEvent(const sf::Event& event);
+  // Called when low-latency mode applies a late pointer sample. If the
+  // pointer moved since the previous sample, the frame consumed input even
+  // when no event for it was polled yet, so it counts from now.
+  void markSampled(sf::Vector2i pointer);
+  std::int64_t nowUs() const;
+
+  // Timestamp of the oldest input consumed by the current frame, or -1.
+  std::int64_t getFrameInputUs() const;
+  // Called after display() for a frame carrying `inputUs`. Thread-safe.
+  void recordPresented(std::int64_t inputUs);
+
+  // Low-latency mode re-samples the mouse right before the frame is
+  // recorded and snaps the aim to it.
+  bool isLowLatency() const;
+  void setLowLatency(bool enabled);
+
+  const LatencyHistogram& getHistogram() const;
+  void resetHistogram();
+};
+
+#endif  // INPUTSYSTEM_H
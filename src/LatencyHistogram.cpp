@@ -0,0 +1,82 @@
+#include "LatencyHistogram.h"
+
+#include <cstdio>
+
+const std::int64_t LatencyHistogram::bucketUpperUs[BUCKET_COUNT] = {
+    2000, 4000, 8000, 12000, 16700, 25000, 33300, 50000, 100000, INT64_MAX};
+
+LatencyHistogram::LatencyHistogram() { reset(); }
+
+void LatencyHistogram::record(std::int64_t latencyUs) {
+  if (latencyUs < 0) {
+    return;
+  }
+  size_t bucket = 0;
+  while (latencyUs > bucketUpperUs[bucket]) {
+    bucket++;
+  }
+  buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+
+  std::int64_t previous = maxUs.load(std::memory_order_relaxed);
+  while (latencyUs > previous &&
+         !maxUs.compare_exchange_weak(previous, latencyUs, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::reset() {
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    buckets[i] = 0;
+  }
+  count = 0;
+  sumUs = 0;
+  maxUs = 0;
+}
+
+std::uint64_t LatencyHistogram::getCount() const { return count; }
+
+float LatencyHistogram::getMeanMs() const {
+  std::uint64_t samples = count;
+  return samples ? sumUs / 1000.0f / samples : 0.0f;
+}
+
+float LatencyHistogram::getMaxMs() const { return maxUs / 1000.0f; }
+
+float LatencyHistogram::getPercentileMs(float percentile) const {
+  std::uint64_t samples = count;
+  if (samples == 0) {
+    return 0.0f;
+  }
+  std::uint64_t rank = static_cast<std::uint64_t>(percentile * samples);
+  std::uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += buckets[i];
+    if (seen > rank) {
+      return i + 1 < BUCKET_COUNT ? bucketUpperUs[i] / 1000.0f : getMaxMs();
+    }
+  }
+  return getMaxMs();
+}
+
+std::string LatencyHistogram::describe() const {
+  char buffer[96];
+  std::snprintf(buffer, sizeof(buffer),
+                "Input->display  mean %.1f ms  p50 <%.1f  p99 <%.1f  max %.1f  n=%llu",
+                getMeanMs(), getPercentileMs(0.5f), getPercentileMs(0.99f),
+                getMaxMs(), static_cast<unsigned long long>(getCount()));
+  std::string result = buffer;
+
+  std::uint64_t samples = count;
+  for (size_t i = 0; i < BUCKET_COUNT && samples > 0; i++) {
+    std::uint64_t n = buckets[i];
+    if (i + 1 < BUCKET_COUNT) {
+      std::snprintf(buffer, sizeof(buffer), "\n  <%5.1f ms ", bucketUpperUs[i] / 1000.0f);
+    } else {
+      std::snprintf(buffer, sizeof(buffer), "\n  >100.0 ms ");
+    }
+    result += buffer;
+    result += std::string(static_cast<size_t>(40 * n / samples), '#');
+  }
+  return result;
+}
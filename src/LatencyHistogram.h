@@ -0,0 +1,36 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fixed-bucket histogram of latencies in microseconds. Recording is
+// lock-free so the render thread can add samples while the simulation
+// thread reads them for the overlay.
+class LatencyHistogram {
+ public:
+  static constexpr size_t BUCKET_COUNT = 10;
+
+ private:
+  static const std::int64_t bucketUpperUs[BUCKET_COUNT];
+  std::atomic<std::uint64_t> buckets[BUCKET_COUNT];
+  std::atomic<std::uint64_t> count;
+  std::atomic<std::int64_t> sumUs;
+  std::atomic<std::int64_t> maxUs;
+
+ public:
+  LatencyHistogram();
+
+  void record(std::int64_t latencyUs);
+  void reset();
+
+  std::uint64_t getCount() const;
+  float getMeanMs() const;
+  float getMaxMs() const;
+  // Upper bound of the bucket containing the given percentile (0..1).
+  float getPercentileMs(float percentile) const;
+  std::string describe() const;
+};
+
+#endif  // LATENCYHISTOGRAM_H
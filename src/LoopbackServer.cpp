@@ -0,0 +1,297 @@
+#include "LoopbackServer.h"
+
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "Projectile.h"
+
+namespace {
+constexpr float kClientTimeout = 3.0f;
+constexpr float kReportInterval = 1.0f;
+constexpr float kPi = 3.14159f;
+const sf::Vector2f kSpawnPosition(400.0f, 300.0f);
+
+std::uint8_t quantizeRotation(float degrees) {
+  float turns = degrees / 360.0f;
+  return static_cast<std::uint8_t>(
+      static_cast<int>((turns - std::floor(turns)) * 256.0f) & 0xff);
+}
+
+std::uint8_t quantizeHealth(float health) {
+  return static_cast<std::uint8_t>(std::clamp(health, 0.0f, 255.0f));
+}
+
+NetEntity makeEntity(NetEntityType type, std::uint32_t localId, sf::Vector2f position,
+                     float rotation, float health) {
+  return {makeNetId(type, localId), static_cast<std::uint8_t>(type),
+          static_cast<std::int32_t>(std::lround(position.x * POSITION_QUANTUM)),
+          static_cast<std::int32_t>(std::lround(position.y * POSITION_QUANTUM)),
+          quantizeRotation(rotation), quantizeHealth(health)};
+}
+}  // namespace
+
+LoopbackServer::LoopbackServer(unsigned short port, int tickRate)
+    : simulation(1), tickRate(tickRate > 0 ? tickRate : DEFAULT_TICK_RATE), running(false) {
+  if (socket.bind(port, sf::IpAddress::LocalHost) != sf::Socket::Status::Done) {
+    throw std::runtime_error("Failed to bind server socket on port " +
+                             std::to_string(port));
+  }
+  socket.setBlocking(false);
+
+  // Same content as the single-player game.
+  simulation.setBulletPatterns(BulletPatternLibrary::load("patterns.txt"));
+  if (std::filesystem::exists("world.bin")) {
+    worldFile.emplace("world.bin");
+    simulation.setWorldFile(&worldFile.value());
+  }
+}
+
+void LoopbackServer::run(float durationSeconds) {
+  running = true;
+  const sf::Time tickTime = sf::seconds(1.0f / tickRate);
+  const float dt = 1.0f / tickRate;
+  sf::Clock sessionClock;
+  sf::Clock tickClock;
+  sf::Clock phaseClock;
+  float reportTimer = 0.0f;
+
+  std::printf("[server] listening on 127.0.0.1 at %d Hz\n", tickRate);
+
+  while (running) {
+    tickClock.restart();
+
+    phaseClock.restart();
+    receivePackets(dt);
+    applyInputs();
+    simulation.step(dt);
+    capture();
+    history.store(current);
+    interval.simMicros += phaseClock.restart().asMicroseconds();
+
+    sendSnapshots();
+    interval.encodeMicros += phaseClock.restart().asMicroseconds();
+    interval.ticks++;
+
+    reportTimer += dt;
+    if (reportTimer >= kReportInterval) {
+      printStats(interval, reportTimer, "interval");
+      total.add(interval);
+      interval = Stats();
+      reportTimer = 0.0f;
+    }
+
+    if (durationSeconds > 0.0f &&
+        sessionClock.getElapsedTime().asSeconds() >= durationSeconds) {
+      running = false;
+    }
+
+    sf::Time elapsed = tickClock.getElapsedTime();
+    if (elapsed < tickTime) {
+      sf::sleep(tickTime - elapsed);
+    }
+  }
+
+  // Include the last partial interval, which has not been reported yet.
+  total.add(interval);
+  interval = Stats();
+  printStats(total, sessionClock.getElapsedTime().asSeconds(), "total");
+}
+
+void LoopbackServer::stop() { running = false; }
+
+void LoopbackServer::Stats::add(const Stats& other) {
+  ticks += other.ticks;
+  simMicros += other.simMicros;
+  encodeMicros += other.encodeMicros;
+  bytesSent += other.bytesSent;
+  packetsSent += other.packetsSent;
+  entityRecordsSent += other.entityRecordsSent;
+  entitySlotsSent += other.entitySlotsSent;
+  fullSnapshots += other.fullSnapshots;
+}
+
+LoopbackServer::ClientSlot* LoopbackServer::findClient(
+    const sf::IpAddress& address, unsigned short port) {
+  for (ClientSlot& client : clients) {
+    if (client.address == address && client.port == port) {
+      return &client;
+    }
+  }
+  return nullptr;
+}
+
+void LoopbackServer::receivePackets(float dt) {
+  for (ClientSlot& client : clients) {
+    client.idleSeconds += dt;
+  }
+
+  std::uint8_t buffer[256];
+  std::size_t received = 0;
+  std::optional<sf::IpAddress> sender;
+  unsigned short senderPort = 0;
+
+  while (socket.receive(buffer, sizeof(buffer), received, sender, senderPort) ==
+         sf::Socket::Status::Done) {
+    if (!sender || received == 0) continue;
+
+    ByteReader reader(buffer, received);
+    MessageType type = static_cast<MessageType>(reader.readU8());
+    ClientSlot* client = findClient(*sender, senderPort);
+
+    if (type == MessageType::Hello && !client) {
+      clients.push_back(
+          {*sender, senderPort, simulation.addPlayer(kSpawnPosition), {}, 0, 0, 0.0f});
+      std::printf("[server] client %s:%u joined (%zu connected)\n",
+                  sender->toString().c_str(), senderPort, clients.size());
+      continue;
+    }
+    if (!client) continue;
+    client->idleSeconds = 0.0f;
+
+    if (type == MessageType::Goodbye) {
+      client->idleSeconds = kClientTimeout;
+    } else if (type == MessageType::Input) {
+      NetInput input;
+      input.sequence = reader.readU32();
+      input.ackTick = reader.readU32();
+      input.moveX = static_cast<std::int8_t>(reader.readU8());
+      input.moveY = static_cast<std::int8_t>(reader.readU8());
+      input.aim = reader.readU8();
+      input.fire = reader.readU8();
+      if (!reader.ok() || input.sequence <= client->lastSequence) continue;
+
+      client->lastSequence = input.sequence;
+      client->ackTick = std::max(client->ackTick, input.ackTick);
+      client->input = input;
+    }
+  }
+
+  for (auto it = clients.begin(); it != clients.end();) {
+    if (it->idleSeconds >= kClientTimeout) {
+      std::printf("[server] client %s:%u left\n", it->address.toString().c_str(),
+                  it->port);
+      simulation.removePlayer(it->playerId);
+      it = clients.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void LoopbackServer::applyInputs() {
+  for (ClientSlot& client : clients) {
+    Player* player = simulation.getPlayer(client.playerId);
+    if (!player) {
+      continue;
+    }
+    // Ships respawn where they fell so clients keep playing.
+    if (player->isDead()) {
+      player->heal(player->getMaxHealth());
+    }
+
+    // Aim 0 is "up"; turn it into a target just ahead of the ship.
+    float angle = (client.input.aim * 360.0f / 256.0f - 90.0f) * kPi / 180.0f;
+    PlayerInput input;
+    input.move = {static_cast<float>(client.input.moveX),
+                  static_cast<float>(client.input.moveY)};
+    input.aimTarget = player->getPos() + sf::Vector2f(std::cos(angle), std::sin(angle)) * 100.0f;
+    input.fire = client.input.fire != 0;
+    simulation.setInput(client.playerId, input);
+  }
+}
+
+void LoopbackServer::capture() {
+  current.tick = static_cast<std::uint32_t>(simulation.getTick());
+  current.entities.clear();
+
+  for (const Simulation::PlayerSlot& slot : simulation.getPlayers()) {
+    const Player& player = *slot.player;
+    current.entities.push_back(makeEntity(NetEntityType::Ship, slot.id, player.getPos(),
+                                          player.getRotation(), player.getHealth()));
+    for (const Projectile* projectile : player.getProjectiles()) {
+      current.entities.push_back(makeEntity(NetEntityType::Bullet, projectile->getId(),
+                                            projectile->getPosition(), 0.0f, 0.0f));
+    }
+  }
+  for (const Enemy* enemy : simulation.getEnemies()) {
+    current.entities.push_back(makeEntity(NetEntityType::Enemy, enemy->getId(),
+                                          enemy->getPosition(),
+                                          enemy->getSprite().getRotation().asDegrees(),
+                                          enemy->getHealth()));
+  }
+  const BulletPool& bullets = simulation.getBullets();
+  for (size_t i = 0; i < bullets.size(); i++) {
+    if (!bullets.isLive(i)) {
+      continue;
+    }
+    current.entities.push_back(makeEntity(NetEntityType::EnemyBullet, bullets.getId(i),
+                                          bullets.getPosition(i), 0.0f, 0.0f));
+  }
+
+  std::sort(current.entities.begin(), current.entities.end(),
+            [](const NetEntity& a, const NetEntity& b) { return a.id < b.id; });
+}
+
+void LoopbackServer::sendSnapshots() {
+  for (ClientSlot& client : clients) {
+    const WorldSnapshot* baseline = history.find(client.ackTick);
+    if (!baseline) {
+      interval.fullSnapshots++;
+    }
+
+    writer.clear();
+    writer.writeU8(static_cast<std::uint8_t>(MessageType::Snapshot));
+    writer.writeVarUInt(makeNetId(NetEntityType::Ship, client.playerId));
+    std::size_t records = SnapshotCodec::encode(current, baseline, writer);
+
+    if (writer.size() > sf::UdpSocket::MaxDatagramSize) {
+      std::fprintf(stderr, "[server] snapshot of %zu bytes dropped\n",
+                   writer.size());
+      continue;
+    }
+    if (socket.send(writer.data(), writer.size(), client.address, client.port) !=
+        sf::Socket::Status::Done) {
+      continue;
+    }
+
+    interval.bytesSent += writer.size();
+    interval.packetsSent++;
+    interval.entityRecordsSent += records;
+    interval.entitySlotsSent += current.entities.size();
+  }
+}
+
+void LoopbackServer::printStats(const Stats& stats, float seconds,
+                                const char* label) const {
+  if (stats.ticks == 0 || seconds <= 0.0f) {
+    return;
+  }
+
+  double tickMs = (stats.simMicros + stats.encodeMicros) / 1000.0 / stats.ticks;
+  double encodeMsPerClient =
+      stats.packetsSent
+          ? stats.encodeMicros / 1000.0 / static_cast<double>(stats.packetsSent)
+          : 0.0;
+  double bytesPerEntity =
+      stats.entitySlotsSent
+          ? static_cast<double>(stats.bytesSent) / stats.entitySlotsSent
+          : 0.0;
+  double bytesPerRecord =
+      stats.entityRecordsSent
+          ? static_cast<double>(stats.bytesSent) / stats.entityRecordsSent
+          : 0.0;
+
+  std::printf(
+      "[server] %s: tick %u clients %zu entities %zu | tick %.3f ms "
+      "(encode %.3f ms/client) | %.1f KB/s out | %.2f B/entity "
+      "%.2f B/changed | %llu full\n",
+      label, static_cast<unsigned>(simulation.getTick()), clients.size(),
+      current.entities.size(), tickMs,
+      encodeMsPerClient, stats.bytesSent / 1024.0 / seconds, bytesPerEntity,
+      bytesPerRecord, static_cast<unsigned long long>(stats.fullSnapshots));
+}
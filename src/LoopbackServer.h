@@ -0,0 +1,71 @@
+#ifndef LOOPBACKSERVER_H
+#define LOOPBACKSERVER_H
+#include <SFML/Network.hpp>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "NetProtocol.h"
+#include "Simulation.h"
+#include "SnapshotCodec.h"
+#include "WorldFile.h"
+
+// Authoritative server: steps the game's Simulation at a fixed tick, one
+// player per client, and sends every connected client a delta snapshot
+// against the newest tick it acknowledged.
+class LoopbackServer {
+ private:
+  struct ClientSlot {
+    sf::IpAddress address;
+    unsigned short port;
+    std::uint32_t playerId;
+    NetInput input;  // newest input, held until the next one arrives
+    std::uint32_t ackTick;
+    std::uint32_t lastSequence;
+    float idleSeconds;
+  };
+
+  struct Stats {
+    std::uint64_t ticks = 0;
+    std::uint64_t simMicros = 0;
+    std::uint64_t encodeMicros = 0;
+    std::uint64_t bytesSent = 0;
+    std::uint64_t packetsSent = 0;
+    std::uint64_t entityRecordsSent = 0;
+    std::uint64_t entitySlotsSent = 0;
+    std::uint64_t fullSnapshots = 0;
+
+    void add(const Stats& other);
+  };
+
+  sf::UdpSocket socket;
+  std::optional<WorldFile> worldFile;
+  Simulation simulation;
+  SnapshotHistory history;
+  WorldSnapshot current;
+  ByteWriter writer;
+  std::vector<ClientSlot> clients;
+  int tickRate;
+  std::atomic<bool> running;
+  Stats interval;
+  Stats total;
+
+  ClientSlot* findClient(const sf::IpAddress& address, unsigned short port);
+  void receivePackets(float dt);
+  void applyInputs();
+  void capture();
+  void sendSnapshots();
+  void printStats(const Stats& stats, float seconds, const char* label) const;
+
+ public:
+  LoopbackServer(unsigned short port = DEFAULT_SERVER_PORT,
+                 int tickRate = DEFAULT_TICK_RATE);
+
+  // Run the fixed-tick loop until stop() or until durationSeconds elapsed
+  // (0 runs forever).
+  void run(float durationSeconds = 0.0f);
+  void stop();
+};
+
+#endif  // LOOPBACKSERVER_H
@@ -0,0 +1,218 @@
+#include "Metrics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+MetricCounter::MetricCounter(std::string name, std::string help)
+    : name(std::move(name)), help(std::move(help)) {}
+
+MetricGauge::MetricGauge(std::string name, std::string help)
+    : name(std::move(name)), help(std::move(help)) {}
+
+MetricHistogram::MetricHistogram(std::string name, std::string help, double exportScale)
+    : name(std::move(name)), help(std::move(help)), exportScale(exportScale) {
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    buckets[i] = 0;
+  }
+}
+
+size_t MetricHistogram::bucketFor(std::uint64_t value) {
+  if (value < 2 * SUB_BUCKETS) {
+    return static_cast<size_t>(value);
+  }
+  int exponent = 63;
+  while (!(value >> exponent)) {
+    exponent--;
+  }
+  if (exponent > MAX_EXPONENT) {
+    return BUCKET_COUNT - 1;
+  }
+  // value has its top bit at `exponent`; keep the next SUB_BUCKET_BITS bits.
+  int shift = exponent - SUB_BUCKET_BITS;
+  size_t sub = static_cast<size_t>(value >> shift);  // SUB_BUCKETS..2*SUB_BUCKETS-1
+  return static_cast<size_t>(shift) * SUB_BUCKETS + sub;
+}
+
+std::uint64_t MetricHistogram::bucketMidpoint(size_t bucket) {
+  if (bucket < 2 * SUB_BUCKETS) {
+    return bucket;
+  }
+  int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+  std::uint64_t sub = bucket % SUB_BUCKETS + SUB_BUCKETS;
+  std::uint64_t low = sub << shift;
+  return low + ((std::uint64_t{1} << shift) >> 1);
+}
+
+void MetricHistogram::record(std::int64_t value) {
+  std::uint64_t v = value < 0 ? 0 : static_cast<std::uint64_t>(value);
+  buckets[bucketFor(v)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(v, std::memory_order_relaxed);
+
+  std::uint64_t previous = maxValue.load(std::memory_order_relaxed);
+  while (v > previous &&
+         !maxValue.compare_exchange_weak(previous, v, std::memory_order_relaxed)) {
+  }
+}
+
+MetricHistogram::Summary MetricHistogram::summarize() const {
+  // Snapshot first so every percentile is computed from the same counts.
+  std::vector<std::uint64_t> snapshot(BUCKET_COUNT);
+  std::uint64_t total = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    snapshot[i] = buckets[i].load(std::memory_order_relaxed);
+    total += snapshot[i];
+  }
+
+  Summary summary{};
+  summary.count = total;
+  summary.sum = sum.load(std::memory_order_relaxed) * exportScale;
+  summary.max = maxValue.load(std::memory_order_relaxed) * exportScale;
+  if (total == 0) {
+    return summary;
+  }
+
+  const double quantiles[3] = {0.5, 0.99, 0.999};
+  double* results[3] = {&summary.p50, &summary.p99, &summary.p999};
+  for (int q = 0; q < 3; q++) {
+    std::uint64_t rank = static_cast<std::uint64_t>(quantiles[q] * (total - 1));
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+      seen += snapshot[i];
+      if (seen > rank) {
+        double value = bucketMidpoint(i) * exportScale;
+        *results[q] = value < summary.max ? value : summary.max;
+        break;
+      }
+    }
+  }
+  return summary;
+}
+
+MetricCounter* MetricsRegistry::addCounter(const std::string& name,
+                                           const std::string& help) {
+  counters.push_back(std::make_unique<MetricCounter>(name, help));
+  return counters.back().get();
+}
+
+MetricGauge* MetricsRegistry::addGauge(const std::string& name, const std::string& help) {
+  gauges.push_back(std::make_unique<MetricGauge>(name, help));
+  return gauges.back().get();
+}
+
+MetricHistogram* MetricsRegistry::addHistogram(const std::string& name,
+                                               const std::string& help,
+                                               double exportScale) {
+  histograms.push_back(std::make_unique<MetricHistogram>(name, help, exportScale));
+  return histograms.back().get();
+}
+
+void MetricsRegistry::writePrometheus(std::ostream& out) const {
+  for (const auto& counter : counters) {
+    out << "# HELP " << counter->name << ' ' << counter->help << '\n'
+        << "# TYPE " << counter->name << " counter\n"
+        << counter->name << ' ' << counter->get() << '\n';
+  }
+  for (const auto& gauge : gauges) {
+    out << "# HELP " << gauge->name << ' ' << gauge->help << '\n'
+        << "# TYPE " << gauge->name << " gauge\n"
+        << gauge->name << ' ' << gauge->get() << '\n';
+  }
+  for (const auto& histogram : histograms) {
+    MetricHistogram::Summary s = histogram->summarize();
+    const std::string& n = histogram->name;
+    out << "# HELP " << n << ' ' << histogram->help << '\n'
+        << "# TYPE " << n << " summary\n"
+        << n << "{quantile=\"0.5\"} " << s.p50 << '\n'
+        << n << "{quantile=\"0.99\"} " << s.p99 << '\n'
+        << n << "{quantile=\"0.999\"} " << s.p999 << '\n'
+        << n << "_sum " << s.sum << '\n'
+        << n << "_count " << s.count << '\n'
+        << "# HELP " << n << "_max Largest recorded value\n"
+        << "# TYPE " << n << "_max gauge\n"
+        << n << "_max " << s.max << '\n';
+  }
+}
+
+void MetricsRegistry::writeJsonLine(std::ostream& out, double uptimeSeconds) const {
+  // Metric names are plain identifiers, so no escaping is needed.
+  out << "{\"uptime_s\":" << uptimeSeconds;
+  for (const auto& counter : counters) {
+    out << ",\"" << counter->name << "\":" << counter->get();
+  }
+  for (const auto& gauge : gauges) {
+    out << ",\"" << gauge->name << "\":" << gauge->get();
+  }
+  for (const auto& histogram : histograms) {
+    MetricHistogram::Summary s = histogram->summarize();
+    out << ",\"" << histogram->name << "\":{\"count\":" << s.count
+        << ",\"p50\":" << s.p50 << ",\"p99\":" << s.p99 << ",\"p999\":" << s.p999
+        << ",\"max\":" << s.max << ",\"mean\":" << (s.count ? s.sum / s.count : 0.0)
+        << '}';
+  }
+  out << "}\n";
+}
+
+MetricsExporter::MetricsExporter(const MetricsRegistry& registry,
+                                 const std::string& directory, float intervalSeconds)
+    : registry(registry),
+      intervalSeconds(intervalSeconds > 0.1f ? intervalSeconds : 0.1f),
+      startTime(std::chrono::steady_clock::now()),
+      stopping(false) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  std::filesystem::path dir(directory);
+  promPath = (dir / "metrics.prom").string();
+  jsonLog.open(dir / "metrics.jsonl", std::ios::app);
+  if (!jsonLog) {
+    throw std::runtime_error("Cannot open metrics log in " + directory);
+  }
+  std::clog << "[metrics] exporting to " << directory << " every "
+            << this->intervalSeconds << " s" << std::endl;
+  worker = std::thread(&MetricsExporter::loop, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeUp.notify_all();
+  worker.join();
+  exportNow();
+}
+
+void MetricsExporter::loop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  auto interval = std::chrono::duration<float>(intervalSeconds);
+  while (!wakeUp.wait_for(lock, interval, [this] { return stopping; })) {
+    lock.unlock();
+    exportNow();
+    lock.lock();
+  }
+}
+
+void MetricsExporter::exportNow() {
+  double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                startTime).count();
+
+  // Write then rename so a scraper never reads a half-written file.
+  std::string tmpPath = promPath + ".tmp";
+  {
+    std::ofstream prom(tmpPath, std::ios::trunc);
+    registry.writePrometheus(prom);
+  }
+  std::error_code error;
+  std::filesystem::rename(tmpPath, promPath, error);
+  if (error) {
+    std::cerr << "[metrics] failed to write " << promPath << ": " << error.message()
+              << std::endl;
+  }
+
+  registry.writeJsonLine(jsonLog, uptime);
+  jsonLog.flush();
+}
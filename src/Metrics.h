@@ -0,0 +1,126 @@
+#ifndef METRICS_H
+#define METRICS_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Monotonic event count.
+class MetricCounter {
+  std::atomic<std::uint64_t> value{0};
+
+ public:
+  const std::string name;
+  const std::string help;
+
+  MetricCounter(std::string name, std::string help);
+  void add(std::uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+  std::uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Last observed value.
+class MetricGauge {
+  std::atomic<std::int64_t> value{0};
+
+ public:
+  const std::string name;
+  const std::string help;
+
+  MetricGauge(std::string name, std::string help);
+  void set(std::int64_t v) { value.store(v, std::memory_order_relaxed); }
+  std::int64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// HDR-style log-linear histogram of non-negative integers: values below 32
+// get exact buckets, above that every power of two is split into 16 linear
+// sub-buckets, so any recorded value is known to within ~6%. Recording is a
+// handful of relaxed atomic adds and never blocks.
+class MetricHistogram {
+ public:
+  static constexpr int SUB_BUCKET_BITS = 4;
+  static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr int MAX_EXPONENT = 40;
+  static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+  struct Summary {
+    std::uint64_t count;
+    double sum;
+    double max;
+    double p50;
+    double p99;
+    double p999;
+  };
+
+ private:
+  std::atomic<std::uint64_t> buckets[BUCKET_COUNT];
+  std::atomic<std::uint64_t> count{0};
+  std::atomic<std::uint64_t> sum{0};
+  std::atomic<std::uint64_t> maxValue{0};
+
+  static size_t bucketFor(std::uint64_t value);
+  static std::uint64_t bucketMidpoint(size_t bucket);
+
+ public:
+  const std::string name;
+  const std::string help;
+  const double exportScale;  // e.g. 1e-6 to export microseconds as seconds
+
+  MetricHistogram(std::string name, std::string help, double exportScale);
+
+  void record(std::int64_t value);
+  // Percentiles (0..1) and totals, already multiplied by exportScale.
+  Summary summarize() const;
+};
+
+// Owns every metric. Register during start-up only; recording and export
+// are safe from any thread afterwards.
+class MetricsRegistry {
+  std::vector<std::unique_ptr<MetricCounter>> counters;
+  std::vector<std::unique_ptr<MetricGauge>> gauges;
+  std::vector<std::unique_ptr<MetricHistogram>> histograms;
+
+ public:
+  MetricCounter* addCounter(const std::string& name, const std::string& help);
+  MetricGauge* addGauge(const std::string& name, const std::string& help);
+  MetricHistogram* addHistogram(const std::string& name, const std::string& help,
+                                double exportScale = 1.0);
+
+  void writePrometheus(std::ostream& out) const;
+  void writeJsonLine(std::ostream& out, double uptimeSeconds) const;
+};
+
+// Background thread that periodically rewrites `<dir>/metrics.prom` and
+// appends a line to `<dir>/metrics.jsonl`. A final export runs on shutdown.
+class MetricsExporter {
+  const MetricsRegistry& registry;
+  std::string promPath;
+  std::ofstream jsonLog;
+  float intervalSeconds;
+  std::chrono::steady_clock::time_point startTime;
+
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  bool stopping;
+  std::thread worker;
+
+  void exportNow();
+  void loop();
+
+ public:
+  MetricsExporter(const MetricsRegistry& registry, const std::string& directory,
+                  float intervalSeconds);
+  ~MetricsExporter();
+
+  MetricsExporter(const MetricsExporter&) = delete;
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+#endif  // METRICS_H
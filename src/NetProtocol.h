@@ -0,0 +1,136 @@
+#ifndef NETPROTOCOL_H
+#define NETPROTOCOL_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wire protocol shared by the loopback server and its clients.
+// All multi-byte values are little endian; integers inside snapshots are
+// zig-zag varints so small deltas cost a single byte.
+
+constexpr unsigned short DEFAULT_SERVER_PORT = 47020;
+constexpr int DEFAULT_TICK_RATE = 30;
+// Positions are quantized to 1/8 of a world unit.
+constexpr float POSITION_QUANTUM = 8.0f;
+// Snapshot history kept on both ends for delta baselines.
+constexpr std::uint32_t SNAPSHOT_HISTORY = 64;
+
+enum class MessageType : std::uint8_t {
+  Hello = 1,
+  Input = 2,
+  Snapshot = 3,
+  Goodbye = 4,
+};
+
+enum class NetEntityType : std::uint8_t {
+  Ship = 0,
+  Enemy = 1,
+  Bullet = 2,       // player shot
+  EnemyBullet = 3,
+};
+
+// Each entity kind numbers its own entities; the wire id keeps the kind in
+// the top bits so ids of different kinds never collide.
+constexpr int NET_ID_KIND_SHIFT = 28;
+
+inline std::uint32_t makeNetId(NetEntityType type, std::uint32_t localId) {
+  return (static_cast<std::uint32_t>(type) << NET_ID_KIND_SHIFT) |
+         (localId & ((1u << NET_ID_KIND_SHIFT) - 1));
+}
+
+// Quantized entity state as it travels over the wire.
+struct NetEntity {
+  std::uint32_t id;
+  std::uint8_t type;
+  std::int32_t x;
+  std::int32_t y;
+  std::uint8_t rotation;  // 256 steps per turn
+  std::uint8_t health;
+};
+
+// Input sent from client to server each client frame.
+struct NetInput {
+  std::uint32_t sequence;
+  std::uint32_t ackTick;  // newest snapshot tick the client has decoded
+  std::int8_t moveX;      // -1, 0, 1
+  std::int8_t moveY;
+  std::uint8_t aim;       // 256 steps per turn
+  std::uint8_t fire;
+};
+
+class ByteWriter {
+ private:
+  std::vector<std::uint8_t> buffer;
+
+ public:
+  void clear() { buffer.clear(); }
+  void writeU8(std::uint8_t value) { buffer.push_back(value); }
+  void writeU32(std::uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+      buffer.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+  }
+  void writeVarUInt(std::uint32_t value) {
+    while (value >= 0x80) {
+      buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<std::uint8_t>(value));
+  }
+  void writeVarInt(std::int32_t value) {
+    writeVarUInt((static_cast<std::uint32_t>(value) << 1) ^
+                 static_cast<std::uint32_t>(value >> 31));
+  }
+  const std::uint8_t* data() const { return buffer.data(); }
+  std::size_t size() const { return buffer.size(); }
+};
+
+class ByteReader {
+ private:
+  const std::uint8_t* data;
+  std::size_t size;
+  std::size_t offset;
+  bool failed;
+
+ public:
+  ByteReader(const void* data, std::size_t size)
+      : data(static_cast<const std::uint8_t*>(data)),
+        size(size),
+        offset(0),
+        failed(false) {}
+
+  std::uint8_t readU8() {
+    if (offset >= size) {
+      failed = true;
+      return 0;
+    }
+    return data[offset++];
+  }
+  std::uint32_t readU32() {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+      value |= static_cast<std::uint32_t>(readU8()) << (8 * i);
+    }
+    return value;
+  }
+  std::uint32_t readVarUInt() {
+    std::uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      std::uint8_t byte = readU8();
+      value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    failed = true;
+    return 0;
+  }
+  std::int32_t readVarInt() {
+    std::uint32_t value = readVarUInt();
+    return static_cast<std::int32_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+  bool ok() const { return !failed; }
+  std::size_t remaining() const { return failed ? 0 : size - offset; }
+};
+
+#endif  // NETPROTOCOL_H
@@ -0,0 +1,101 @@
+#include "NetViewer.h"
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+
+#include "ScriptedClient.h"
+
+namespace {
+constexpr float kPi = 3.14159f;
+
+NetInput readInput(const sf::RenderWindow& window, sf::Vector2f shipPos) {
+  NetInput input = {};
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) input.moveX = -1;
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) input.moveX = 1;
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) input.moveY = -1;
+  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) input.moveY = 1;
+
+  // The server treats aim 0 as "up", matching the single-player ship.
+  sf::Vector2f mouse = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+  sf::Vector2f toMouse = mouse - shipPos;
+  float turns = (std::atan2(toMouse.y, toMouse.x) * 180.0f / kPi + 90.0f) / 360.0f;
+  input.aim = static_cast<std::uint8_t>(
+      static_cast<int>((turns - std::floor(turns)) * 256.0f) & 0xff);
+  input.fire = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left) ? 1 : 0;
+  return input;
+}
+}  // namespace
+
+int runNetViewer(unsigned short port, int tickRate, float durationSeconds) {
+  sf::RenderWindow window(sf::VideoMode({1280, 720}), "SpaceShooter - loopback client");
+  window.setVerticalSyncEnabled(true);
+  sf::View view({0.f, 0.f}, {1280.f, 720.f});
+
+  ScriptedClient client(0, port, tickRate);
+  sf::CircleShape ship(10.f, 3);
+  ship.setOrigin({10.f, 10.f});
+  sf::CircleShape enemy(8.f);
+  enemy.setOrigin({8.f, 8.f});
+  enemy.setFillColor(sf::Color(220, 60, 60));
+  sf::RectangleShape bullet({3.f, 3.f});
+  bullet.setOrigin({1.5f, 1.5f});
+  bullet.setFillColor(sf::Color::Yellow);
+  sf::CircleShape enemyBullet(2.f);
+  enemyBullet.setOrigin({2.f, 2.f});
+  enemyBullet.setFillColor(sf::Color(255, 140, 40));
+
+  sf::Clock sessionClock;
+  sf::Clock frameClock;
+  while (window.isOpen()) {
+    while (const std::optional event = window.pollEvent()) {
+      if (event->is<sf::Event::Closed>()) {
+        window.close();
+      }
+    }
+    if (durationSeconds > 0.0f &&
+        sessionClock.getElapsedTime().asSeconds() >= durationSeconds) {
+      window.close();
+    }
+
+    float dt = frameClock.restart().asSeconds();
+    window.setView(view);
+    client.update(dt, readInput(window, view.getCenter()));
+    const std::vector<InterpolatedEntity>& entities = client.interpolate();
+
+    for (const InterpolatedEntity& entity : entities) {
+      if (entity.id == client.getShipId()) {
+        view.setCenter({entity.x, entity.y});
+      }
+    }
+    window.setView(view);
+    window.clear(sf::Color(10, 10, 25));
+    for (const InterpolatedEntity& entity : entities) {
+      sf::Vector2f position(entity.x, entity.y);
+      switch (static_cast<NetEntityType>(entity.type)) {
+        case NetEntityType::Ship:
+          ship.setFillColor(entity.id == client.getShipId() ? sf::Color(80, 160, 255)
+                                                            : sf::Color(160, 160, 160));
+          ship.setPosition(position);
+          window.draw(ship);
+          break;
+        case NetEntityType::Enemy:
+          enemy.setPosition(position);
+          window.draw(enemy);
+          break;
+        case NetEntityType::Bullet:
+          bullet.setPosition(position);
+          window.draw(bullet);
+          break;
+        case NetEntityType::EnemyBullet:
+          enemyBullet.setPosition(position);
+          window.draw(enemyBullet);
+          break;
+      }
+    }
+    window.display();
+  }
+
+  client.disconnect();
+  client.printStats(sessionClock.getElapsedTime().asSeconds());
+  return 0;
+}
@@ -0,0 +1,12 @@
+#ifndef NETVIEWER_H
+#define NETVIEWER_H
+#include "NetProtocol.h"
+
+// Minimal rendering client for the loopback server: sends WASD movement,
+// mouse aim and the left button as input, and draws the interpolated
+// snapshot entities as flat shapes around the player's ship. Runs until the
+// window closes (or for durationSeconds when > 0); returns an exit code.
+int runNetViewer(unsigned short port = DEFAULT_SERVER_PORT,
+                 int tickRate = DEFAULT_TICK_RATE, float durationSeconds = 0.0f);
+
+#endif  // NETVIEWER_H
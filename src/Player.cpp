@@ -1,5 +1,4 @@
 #include <SFML/Graphics.hpp>
-#include <SFML/Window/Keyboard.hpp>
 #include <cmath>
 
 #include "Player.h"
@@ -20,9 +19,8 @@ struct TextureInitializer {
   }
 } textureInit;
 
-Player::Player(sf::Vector2f pos, sf::RenderWindow* window)
-    : window(window),
-      PlayerSprite(sharedPlayerTexture),
+Player::Player(sf::Vector2f pos)
+    : PlayerSprite(sharedPlayerTexture),
       health(200.0f),
       maxHealth(200.0f),
       position(pos),
@@ -33,7 +31,8 @@ Player::Player(sf::Vector2f pos, sf::RenderWindow* window)
       targetRotation(0.0f),
       rotationSpeed(500.0f),
       lastCollisionTime(0.0f),
-      collisionCooldown(1.0f) {
+      collisionCooldown(1.0f),
+      triggerHeld(false) {
   PlayerSprite.setTexture(sharedPlayerTexture);
   PlayerSprite.setScale({0.8f, 0.8f});
 
@@ -41,32 +40,23 @@ Player::Player(sf::Vector2f pos, sf::RenderWindow* window)
   PlayerSprite.setOrigin({bounds.size.x / 2.0f, bounds.size.y / 2.0f});
   PlayerSprite.setPosition(position);
 }
-Player::~Player() = default;
+Player::~Player() {
+  for (Projectile* projectile : projectiles) {
+    delete projectile;
+  }
+  projectiles.clear();
+}
 
 void Player::update() {
   PlayerSprite.setPosition(position);
   PlayerSprite.setRotation(sf::degrees(currentRotation));
 }
 
-void Player::handleInput(float dt) {
-  velocity = {0.f, 0.f};
+void Player::applyInput(const PlayerInput& input, float dt) {
+  velocity = input.move * PLAYER_SPEED;
+  triggerHeld = input.fire;
 
-  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
-    velocity.x = -PLAYER_SPEED;
-  } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
-    velocity.x = PLAYER_SPEED;
-  }
-
-  if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
-    velocity.y = -PLAYER_SPEED;
-  } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
-    velocity.y = PLAYER_SPEED;
-  }
-
-  sf::Vector2i mousePos = sf::Mouse::getPosition(*window);
-  sf::Vector2f worldMousePos = window->mapPixelToCoords(mousePos);
-
-  sf::Vector2f direction = worldMousePos - position;
+  sf::Vector2f direction = input.aimTarget - position;
   if (direction.x != 0.0f || direction.y != 0.0f) {
     targetRotation = std::atan2(direction.y, direction.x) * 180.0f / 3.14159f;
     targetRotation += 90.0f;
@@ -87,7 +77,6 @@ void Player::handleInput(float dt) {
   }
 
   shoot();
-  updateProjectiles(dt);
 }
 
 sf::Vector2f Player::getPos() const { return position; }
@@ -101,7 +90,7 @@ sf::FloatRect Player::getGlobalBounds() const {
 const sf::Sprite& Player::getSprite() const { return PlayerSprite; }
 
 void Player::shoot() {
-  if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left)) {
+  if (triggerHeld) {
     if (lastShotTime >= shootCooldown) {
       float angleRad = (currentRotation - 90.0f) * 3.14159f / 180.0f;
       sf::Vector2f shootDirection(std::cos(angleRad), std::sin(angleRad));
@@ -115,10 +104,10 @@ void Player::shoot() {
   }
 }
 
-void Player::updateProjectiles(float dt) {
+void Player::updateProjectiles(float dt, const sf::View& view) {
   for (size_t i = 0; i < projectiles.size(); i++) {
     projectiles[i]->move(dt);
-    if (projectiles[i]->checkOutOfBounds(window)) {
+    if (projectiles[i]->checkOutOfBounds(view)) {
       delete projectiles[i];
       projectiles.erase(projectiles.begin() + i);
       i--;
@@ -126,6 +115,22 @@ void Player::updateProjectiles(float dt) {
   }
 }
 
+// Aim straight at a freshly sampled target, skipping the rotation easing so
+// the frame about to be drawn reflects the newest mouse position.
+void Player::lateAim(sf::Vector2f aimTarget) {
+  sf::Vector2f direction = aimTarget - position;
+  if (direction.x == 0.0f && direction.y == 0.0f) {
+    return;
+  }
+
+  targetRotation = std::atan2(direction.y, direction.x) * 180.0f / 3.14159f + 90.0f;
+  while (targetRotation >= 360.0f) targetRotation -= 360.0f;
+  while (targetRotation < 0.0f) targetRotation += 360.0f;
+
+  currentRotation = targetRotation;
+  PlayerSprite.setRotation(sf::degrees(currentRotation));
+}
+
 void Player::updateRotation(float dt) {
   float angleDiff = targetRotation - currentRotation;
 
@@ -159,7 +164,15 @@ void Player::takeDamage(float damage) {
   lastCollisionTime = 0.0f;
 }
 
+void Player::heal(float amount) {
+  health += amount;
+  if (health > maxHealth) {
+    health = maxHealth;
+  }
+}
+
 void Player::removeProjectiles(size_t projIndex) {
+  delete projectiles[projIndex];
   projectiles.erase(projectiles.begin() + projIndex);
 }
 bool Player::isDead() const { return health <= 0.0f; }
@@ -168,6 +181,8 @@ float Player::getHealth() const { return health; }
 
 float Player::getMaxHealth() const { return maxHealth; }
 
+float Player::getRotation() const { return currentRotation; }
+
 bool Player::canTakeCollisionDamage() {
   return lastCollisionTime >= collisionCooldown;
 }
@@ -3,12 +3,20 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 
+#include "AllocTracker.h"
+
 class Projectile;
 class Asteroid;
 
-class Player {
+// One frame of player intent, either sampled from the devices or scripted.
+struct PlayerInput {
+  sf::Vector2f move;       // -1..1 per axis
+  sf::Vector2f aimTarget;  // world coordinates
+  bool fire = false;
+};
+
+class Player : public TrackedAllocation<AllocCategory::Player> {
  private:
-  sf::RenderWindow* window;
   sf::Sprite PlayerSprite;
   float health;
   float maxHealth;
@@ -22,18 +30,21 @@ class Player {
   float rotationSpeed;
   float lastCollisionTime;
   float collisionCooldown;
+  bool triggerHeld;
 
  public:
   // constructor and destructor
-  Player(sf::Vector2f startPos, sf::RenderWindow* w);
+  explicit Player(sf::Vector2f startPos);
   ~Player();
 
   // utility functions
-  void handleInput(float dt);
+  void applyInput(const PlayerInput& input, float dt);
+  void lateAim(sf::Vector2f aimTarget);
   void shoot();
-  void updateProjectiles(float dt);
+  void updateProjectiles(float dt, const sf::View& view);
   void updateRotation(float dt);
   void takeDamage(float damage);
+  void heal(float amount);
   bool canTakeCollisionDamage();
   bool isDead() const;
   bool checkCollision();
@@ -47,6 +58,7 @@ class Player {
   const std::vector<Projectile*>& getProjectiles() const;
   float getHealth() const;
   float getMaxHealth() const;
+  float getRotation() const;
 
   // setters
   void setPos(sf::Vector2f newPos);
@@ -11,7 +11,7 @@ struct TextureInitializer {
   }
 } projTextureInit;
 
-Projectile::Projectile(sf::Vector2f pos, sf::Vector2f direction) : sprite(sharedProjTexture) , damage(5), pos(pos){
+Projectile::Projectile(sf::Vector2f pos, sf::Vector2f direction) : sprite(sharedProjTexture) , damage(5), pos(pos), id(0){
 
     if(!loaded){
         (void)sharedProjTexture.loadFromFile("proj.png");
@@ -35,11 +35,10 @@ Projectile::Projectile(sf::Vector2f pos, sf::Vector2f direction) : sprite(shared
 
 Projectile::~Projectile() = default;
 
-bool Projectile::checkOutOfBounds(sf::RenderWindow *window){
-    sf::View currentView = window->getView();
+bool Projectile::checkOutOfBounds(const sf::View& view) const {
     sf::FloatRect viewBounds(
-        currentView.getCenter() - currentView.getSize() / 2.f,
-        currentView.getSize()
+        view.getCenter() - view.getSize() / 2.f,
+        view.getSize()
     );
     
     sf::Vector2f projPos = sprite.getPosition();
@@ -63,4 +62,16 @@ void Projectile::move(float dt){
 
 const sf::Sprite& Projectile::getSprite() const {
     return sprite;
-}
\ No newline at end of file
+}
+
+sf::Vector2f Projectile::getPosition() const {
+    return pos;
+}
+
+std::uint32_t Projectile::getId() const {
+    return id;
+}
+
+void Projectile::setId(std::uint32_t newId){
+    id = newId;
+}
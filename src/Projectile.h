@@ -1,15 +1,18 @@
 #ifndef PROJECTILE_H
 #define PROJECTILE_H
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
+#include "AllocTracker.h"
 #include "Enemy.h"
-class Projectile {
+class Projectile : public TrackedAllocation<AllocCategory::Projectile> {
  private:
   sf::Texture texture;
   sf::Sprite sprite;
   int damage;
   sf::Vector2f pos;
   sf::Vector2f velocity;
+  std::uint32_t id;  // 0 until the simulation assigns one
 
  public:
   Projectile(sf::Vector2f pos, sf::Vector2f direction);
@@ -17,8 +20,11 @@ class Projectile {
   // utility functions
   void move(float dt);  // this will be used to move the projectile each frame
   bool CheckColission(const Enemy* other);
-  bool checkOutOfBounds(sf::RenderWindow* window);
+  bool checkOutOfBounds(const sf::View& view) const;
   const sf::Sprite& getSprite() const;
+  sf::Vector2f getPosition() const;
+  std::uint32_t getId() const;
+  void setId(std::uint32_t newId);
 };
 
 #endif
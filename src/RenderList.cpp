@@ -0,0 +1,116 @@
+#include "RenderList.h"
+
+void RenderList::clear() {
+  commands.clear();
+  vertexBuffersUsed = 0;
+  starfieldBuffersUsed = 0;
+  overlayStart = 0;
+  inputTimestampUs = -1;
+}
+
+void RenderList::setView(const sf::View& view) { commands.emplace_back(view); }
+
+void RenderList::addSprite(const sf::Sprite& sprite) {
+  commands.emplace_back(SpriteCommand{&sprite.getTexture(), sprite.getTextureRect(),
+                                      sprite.getTransform(), sprite.getColor()});
+}
+
+void RenderList::addShape(const sf::RectangleShape& shape) {
+  commands.emplace_back(shape);
+}
+
+void RenderList::addText(const sf::Text& text) {
+  // sf::Text builds its glyph quads lazily, looking glyphs up in the font.
+  // Do it here, on the recording thread, so the copy handed to the render
+  // thread is already built and drawing it never touches the font's glyph
+  // tables while the simulation is calling setString()/getLocalBounds().
+  (void)text.getLocalBounds();
+  commands.emplace_back(text);
+}
+
+std::vector<sf::Vertex>& RenderList::addVertices(sf::PrimitiveType type) {
+  if (vertexBuffersUsed == vertexBuffers.size()) {
+    vertexBuffers.emplace_back();
+  }
+  std::vector<sf::Vertex>& vertices = vertexBuffers[vertexBuffersUsed];
+  vertices.clear();
+  commands.emplace_back(VertexCommand{vertexBuffersUsed, type});
+  vertexBuffersUsed++;
+  return vertices;
+}
+
+std::vector<StarfieldChunk>& RenderList::addStarfield(StarfieldCache* cache) {
+  if (starfieldBuffersUsed == starfieldBuffers.size()) {
+    starfieldBuffers.emplace_back();
+  }
+  std::vector<StarfieldChunk>& chunks = starfieldBuffers[starfieldBuffersUsed];
+  chunks.clear();
+  commands.emplace_back(StarfieldCommand{cache, starfieldBuffersUsed});
+  starfieldBuffersUsed++;
+  return chunks;
+}
+
+void RenderList::beginOverlayPass() { overlayStart = commands.size(); }
+
+void RenderList::setInputTimestamp(std::int64_t timestampUs) {
+  inputTimestampUs = timestampUs;
+}
+
+std::int64_t RenderList::getInputTimestamp() const { return inputTimestampUs; }
+
+size_t RenderList::size() const { return commands.size(); }
+
+size_t RenderList::draw(sf::RenderTarget& target) const {
+  return drawRange(target, 0, commands.size(), nullptr);
+}
+
+size_t RenderList::drawWorld(sf::RenderTarget& target,
+                             const sf::FloatRect& viewport) const {
+  size_t end = overlayStart > 0 ? overlayStart : commands.size();
+  return drawRange(target, 0, end, &viewport);
+}
+
+size_t RenderList::drawOverlay(sf::RenderTarget& target) const {
+  if (overlayStart == 0) {
+    return 0;
+  }
+  return drawRange(target, overlayStart, commands.size(), nullptr);
+}
+
+size_t RenderList::drawRange(sf::RenderTarget& target, size_t begin, size_t end,
+                             const sf::FloatRect* viewport) const {
+  size_t drawCalls = 0;
+  for (size_t i = begin; i < end; i++) {
+    const Command& command = commands[i];
+    if (const sf::View* view = std::get_if<sf::View>(&command)) {
+      if (viewport) {
+        sf::View scaled = *view;
+        scaled.setViewport(*viewport);
+        target.setView(scaled);
+      } else {
+        target.setView(*view);
+      }
+    } else if (const SpriteCommand* sprite = std::get_if<SpriteCommand>(&command)) {
+      sf::Sprite drawable(*sprite->texture, sprite->textureRect);
+      drawable.setColor(sprite->color);
+      target.draw(drawable, sf::RenderStates(sprite->transform));
+      drawCalls++;
+    } else if (const sf::RectangleShape* shape = std::get_if<sf::RectangleShape>(&command)) {
+      target.draw(*shape);
+      drawCalls++;
+    } else if (const sf::Text* text = std::get_if<sf::Text>(&command)) {
+      target.draw(*text);
+      drawCalls++;
+    } else if (const VertexCommand* batch = std::get_if<VertexCommand>(&command)) {
+      const std::vector<sf::Vertex>& vertices = vertexBuffers[batch->buffer];
+      if (!vertices.empty()) {
+        target.draw(vertices.data(), vertices.size(), batch->type);
+        drawCalls++;
+      }
+    } else if (const StarfieldCommand* starfield = std::get_if<StarfieldCommand>(&command)) {
+      drawCalls += starfield->cache->draw(target, starfieldBuffers[starfield->buffer],
+                                          sf::RenderStates::Default);
+    }
+  }
+  return drawCalls;
+}
@@ -0,0 +1,81 @@
+#ifndef RENDERLIST_H
+#define RENDERLIST_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include "Starfield.h"
+
+// Immutable snapshot of everything drawn in one frame. The simulation fills
+// it, then hands it to whoever owns the window (inline or the render thread).
+// Sprites reference long-lived shared textures. Text is copied with its glyph
+// geometry already built by addText(), so the render thread only reads the
+// font's glyph texture, which the game fills up front. The starfield cache
+// is owned by the game but only ever touched while drawing.
+class RenderList {
+ public:
+  struct SpriteCommand {
+    const sf::Texture* texture;
+    sf::IntRect textureRect;
+    sf::Transform transform;
+    sf::Color color;
+  };
+
+  struct VertexCommand {
+    size_t buffer;  // index into vertexBuffers
+    sf::PrimitiveType type;
+  };
+
+  struct StarfieldCommand {
+    StarfieldCache* cache;
+    size_t buffer;  // index into starfieldBuffers
+  };
+
+  using Command = std::variant<sf::View, SpriteCommand, sf::RectangleShape, sf::Text,
+                               VertexCommand, StarfieldCommand>;
+
+ private:
+  std::vector<Command> commands;
+  // Vertex storage for VertexCommands. clear() keeps the buffers and their
+  // capacity, so steady-state frames build geometry without allocating.
+  std::vector<std::vector<sf::Vertex>> vertexBuffers;
+  size_t vertexBuffersUsed = 0;
+  // Tile lists for StarfieldCommands, reused the same way.
+  std::vector<std::vector<StarfieldChunk>> starfieldBuffers;
+  size_t starfieldBuffersUsed = 0;
+  size_t overlayStart = 0;
+  std::int64_t inputTimestampUs = -1;
+
+  size_t drawRange(sf::RenderTarget& target, size_t begin, size_t end,
+                   const sf::FloatRect* viewport) const;
+
+ public:
+  void clear();
+  void setView(const sf::View& view);
+  void addSprite(const sf::Sprite& sprite);
+  void addShape(const sf::RectangleShape& shape);
+  void addText(const sf::Text& text);
+  // Untextured geometry drawn in a single call. Returns an empty buffer for
+  // the caller to fill; it is reused (with its capacity) on later frames.
+  std::vector<sf::Vertex>& addVertices(sf::PrimitiveType type);
+  // Tiles drawn from `cache`. Returns an empty, reused list to fill, like
+  // addVertices().
+  std::vector<StarfieldChunk>& addStarfield(StarfieldCache* cache);
+  // Everything recorded after this call belongs to the native-resolution
+  // overlay pass (HUD); everything before it to the world pass.
+  void beginOverlayPass();
+
+  // Timestamp of the oldest input this frame consumed, -1 for none.
+  void setInputTimestamp(std::int64_t timestampUs);
+  std::int64_t getInputTimestamp() const;
+
+  size_t size() const;
+  // Replays the commands onto `target` and returns the number of draw calls.
+  size_t draw(sf::RenderTarget& target) const;
+  // World pass only, with every view squeezed into `viewport`.
+  size_t drawWorld(sf::RenderTarget& target, const sf::FloatRect& viewport) const;
+  size_t drawOverlay(sf::RenderTarget& target) const;
+};
+
+#endif  // RENDERLIST_H
@@ -0,0 +1,87 @@
+#include "RenderThread.h"
+
+#include <iostream>
+#include <utility>
+
+RenderThread::RenderThread(sf::RenderWindow& window, PresentCallback onPresented,
+                           ResolutionScaler* scaler)
+    : window(window),
+      frontPending(false),
+      drawing(false),
+      stopping(false),
+      lastRenderMs(0.0f),
+      lastDrawCalls(0),
+      onPresented(std::move(onPresented)),
+      scaler(scaler) {
+  if (!window.setActive(false)) {
+    std::cerr << "[render] failed to release GL context" << std::endl;
+  }
+  thread = std::thread(&RenderThread::renderLoop, this);
+}
+
+RenderThread::~RenderThread() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  cv.notify_all();
+  thread.join();
+
+  if (!window.setActive(true)) {
+    std::cerr << "[render] failed to reacquire GL context" << std::endl;
+  }
+}
+
+RenderList& RenderThread::acquire() {
+  back.clear();
+  return back;
+}
+
+void RenderThread::submit() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [this]() { return !frontPending && !drawing; });
+  std::swap(back, front);
+  frontPending = true;
+  lock.unlock();
+  cv.notify_all();
+}
+
+void RenderThread::renderLoop() {
+  if (!window.setActive(true)) {
+    std::cerr << "[render] failed to activate GL context" << std::endl;
+  }
+
+  sf::Clock renderClock;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this]() { return frontPending || stopping; });
+      if (!frontPending && stopping) {
+        break;
+      }
+      frontPending = false;
+      drawing = true;
+    }
+
+    renderClock.restart();
+    window.clear();
+    lastDrawCalls = scaler ? scaler->render(front, window) : front.draw(window);
+    lastRenderMs = renderClock.getElapsedTime().asSeconds() * 1000.0f;
+    window.display();
+    if (onPresented) {
+      onPresented(front);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      drawing = false;
+    }
+    cv.notify_all();
+  }
+
+  (void)window.setActive(false);
+}
+
+float RenderThread::getLastRenderMs() const { return lastRenderMs; }
+
+size_t RenderThread::getLastDrawCalls() const { return lastDrawCalls; }
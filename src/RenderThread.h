@@ -0,0 +1,60 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "RenderList.h"
+#include "ResolutionScaler.h"
+
+// Owns the window's GL context on a dedicated thread and draws the previous
+// frame's RenderList while the simulation builds the next one.
+class RenderThread {
+ public:
+  // Runs on the render thread right after display() returns.
+  using PresentCallback = std::function<void(const RenderList&)>;
+
+ private:
+  sf::RenderWindow& window;
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cv;
+  RenderList back;   // filled by the simulation thread
+  RenderList front;  // consumed by the render thread
+  bool frontPending;
+  bool drawing;
+  bool stopping;
+  std::atomic<float> lastRenderMs;
+  std::atomic<size_t> lastDrawCalls;
+  PresentCallback onPresented;
+  ResolutionScaler* scaler;
+
+  void renderLoop();
+
+ public:
+  // Deactivates the window's context on the calling thread and starts
+  // rendering. The window must outlive this object.
+  explicit RenderThread(sf::RenderWindow& window,
+                        PresentCallback onPresented = PresentCallback(),
+                        ResolutionScaler* scaler = nullptr);
+  // Finishes the frame in flight and hands the context back to the caller.
+  ~RenderThread();
+  RenderThread(const RenderThread&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+
+  // List for the simulation to fill for the next frame.
+  RenderList& acquire();
+  // Publish the acquired list. Blocks only while the render thread is still
+  // drawing the previous frame.
+  void submit();
+
+  // CPU time spent clearing and drawing the last frame, excluding the
+  // display() call so vsync waits don't count as render cost.
+  float getLastRenderMs() const;
+  size_t getLastDrawCalls() const;
+};
+
+#endif  // RENDERTHREAD_H
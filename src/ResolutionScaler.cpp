@@ -0,0 +1,204 @@
+#include "ResolutionScaler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+constexpr float kSmoothing = 0.1f;
+constexpr float kScaleStep = 0.05f;
+constexpr float kDownRatio = 1.05f;
+constexpr float kUpRatio = 0.7f;
+constexpr int kUpFrames = 90;
+constexpr int kCooldownFrames = 20;
+
+float quantize(float scale) {
+  return std::round(scale / kScaleStep) * kScaleStep;
+}
+}  // namespace
+
+ResolutionScaler::ResolutionScaler(float minScale, float maxScale, float budgetMs)
+    : minScale(std::clamp(minScale, 0.1f, 1.0f)),
+      maxScale(std::clamp(maxScale, 0.1f, 1.0f)),
+      budgetMs(budgetMs),
+      maxScaleCap(1.0f),
+      scale(0.0f),
+      smoothedWorldMs(0.0f),
+      nativeOnly(false),
+      framesUnderBudget(0),
+      cooldownFrames(0),
+      targetSize(0, 0) {
+  if (this->minScale > this->maxScale) {
+    std::swap(this->minScale, this->maxScale);
+  }
+  scale = this->maxScale;
+}
+
+bool ResolutionScaler::isEnabled() const { return minScale < 1.0f && !nativeOnly; }
+
+bool ResolutionScaler::ensureTarget(sf::Vector2u windowSize) {
+  // Allocate once at the maximum scale; lower scales only use a corner of
+  // the texture, so changing scale never reallocates.
+  sf::Vector2u wanted(static_cast<unsigned>(windowSize.x * maxScale),
+                      static_cast<unsigned>(windowSize.y * maxScale));
+  if (target && targetSize == wanted) {
+    return true;
+  }
+
+  target.emplace();
+  if (!target->resize(wanted)) {
+    std::cerr << "[resolution] failed to create " << wanted.x << "x" << wanted.y
+              << " render target, drawing at native resolution" << std::endl;
+    target.reset();
+    nativeOnly = true;
+    return false;
+  }
+  target->setSmooth(true);
+  targetSize = wanted;
+  return true;
+}
+
+size_t ResolutionScaler::render(const RenderList& list, sf::RenderWindow& window) {
+  if (!isEnabled() || !ensureTarget(window.getSize())) {
+    return list.draw(window);
+  }
+
+  float current = scale;
+  float fraction = current / maxScale;
+  sf::FloatRect viewport({0.f, 0.f}, {fraction, fraction});
+
+  size_t drawCalls = 0;
+  if (std::optional<float> worldMs = drawWorld(list, viewport, window.getSettings(), drawCalls)) {
+    adjust(*worldMs);
+  }
+
+  sf::Vector2u windowSize = window.getSize();
+  sf::Vector2i used(static_cast<int>(targetSize.x * fraction),
+                    static_cast<int>(targetSize.y * fraction));
+  sf::Sprite upscaled(target->getTexture(), sf::IntRect({0, 0}, used));
+  upscaled.setScale({static_cast<float>(windowSize.x) / used.x,
+                     static_cast<float>(windowSize.y) / used.y});
+
+  window.setView(window.getDefaultView());
+  window.draw(upscaled);
+  drawCalls++;
+
+  drawCalls += list.drawOverlay(window);
+  return drawCalls;
+}
+
+std::optional<float> ResolutionScaler::drawWorld(const RenderList& list,
+                                                 sf::FloatRect viewport,
+                                                 const sf::ContextSettings& settings,
+                                                 size_t& drawCalls) {
+  // Timer queries belong to one context, so create and issue them with the
+  // render texture's context active.
+  (void)target->setActive(true);
+  if (!gpuTimer) {
+    gpuTimer.emplace(settings);
+    if (!gpuTimer->isAvailable()) {
+      std::clog << "[resolution] no GL timer queries, timing the world pass with glFinish"
+                << std::endl;
+    }
+  }
+
+  if (!gpuTimer->isAvailable()) {
+    // CPU time only covers command submission; waiting for the GPU makes it
+    // include the fill cost this scaler exists to reduce.
+    sf::Clock worldClock;
+    target->clear();
+    drawCalls = list.drawWorld(*target, viewport);
+    target->display();
+    (void)target->setActive(true);
+    GpuTimer::finish();
+    return worldClock.getElapsedTime().asSeconds() * 1000.0f;
+  }
+
+  gpuTimer->begin();
+  target->clear();
+  drawCalls = list.drawWorld(*target, viewport);
+  target->display();
+  (void)target->setActive(true);
+  gpuTimer->end();
+
+  float gpuMs = 0.0f;
+  if (gpuTimer->collect(gpuMs)) {
+    return gpuMs;
+  }
+  return std::nullopt;
+}
+
+void ResolutionScaler::releaseGpuResources() {
+  if (target && gpuTimer) {
+    (void)target->setActive(true);
+  }
+  gpuTimer.reset();
+  target.reset();
+  targetSize = {0, 0};
+}
+
+void ResolutionScaler::adjust(float worldMs) {
+  float smoothed = smoothedWorldMs;
+  smoothed = smoothed == 0.0f ? worldMs : smoothed + (worldMs - smoothed) * kSmoothing;
+  smoothedWorldMs = smoothed;
+
+  float current = scale;
+  float upper = std::min(maxScale, std::max(minScale, static_cast<float>(maxScaleCap)));
+  float next = current;
+
+  if (cooldownFrames > 0) {
+    cooldownFrames--;
+  } else if (smoothed > budgetMs * kDownRatio) {
+    next = current - kScaleStep;
+    framesUnderBudget = 0;
+  } else if (smoothed < budgetMs * kUpRatio) {
+    if (++framesUnderBudget >= kUpFrames) {
+      next = current + kScaleStep;
+      framesUnderBudget = 0;
+    }
+  } else {
+    framesUnderBudget = 0;
+  }
+
+  next = std::clamp(quantize(next), minScale, upper);
+  if (next == current) {
+    return;
+  }
+
+  char buffer[128];
+  std::snprintf(buffer, sizeof(buffer),
+                "scale %.2f -> %.2f (world GPU %.2f ms, budget %.2f ms, cap %.2f)",
+                current, next, smoothed, budgetMs, upper);
+  std::clog << "[resolution] " << buffer << std::endl;
+  {
+    std::lock_guard<std::mutex> lock(decisionMutex);
+    lastDecision = buffer;
+  }
+  scale = next;
+  cooldownFrames = kCooldownFrames;
+}
+
+void ResolutionScaler::setMaxScaleCap(float cap) { maxScaleCap = cap; }
+
+float ResolutionScaler::getScale() const { return scale; }
+
+float ResolutionScaler::getMinScale() const { return minScale; }
+
+float ResolutionScaler::getMaxScale() const { return maxScale; }
+
+float ResolutionScaler::getSmoothedWorldMs() const { return smoothedWorldMs; }
+
+std::string ResolutionScaler::describe() const {
+  if (!isEnabled()) {
+    return "Resolution native";
+  }
+  char buffer[128];
+  std::snprintf(buffer, sizeof(buffer),
+                "Resolution %.2f [%.2f..%.2f]  world GPU %.2f ms / %.2f ms",
+                static_cast<float>(scale), minScale, maxScale,
+                static_cast<float>(smoothedWorldMs), budgetMs);
+  std::lock_guard<std::mutex> lock(decisionMutex);
+  return lastDecision.empty() ? std::string(buffer)
+                              : std::string(buffer) + "\n  last: " + lastDecision;
+}
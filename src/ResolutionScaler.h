@@ -0,0 +1,63 @@
+#ifndef RESOLUTIONSCALER_H
+#define RESOLUTIONSCALER_H
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "GpuTimer.h"
+#include "RenderList.h"
+
+// Renders the world pass of a RenderList into an off-screen texture whose
+// effective resolution follows the GPU time of that pass, upscales it to the
+// window, then draws the overlay pass at native resolution. GPU time comes
+// from GL timer queries read back a frame or two later; without them the
+// pass is timed on the CPU after glFinish().
+//
+// render() runs wherever the GL context lives (the render thread); the
+// getters and setMaxScaleCap() may be called from any thread.
+class ResolutionScaler {
+ private:
+  float minScale;
+  float maxScale;
+  float budgetMs;
+  std::atomic<float> maxScaleCap;
+  std::atomic<float> scale;
+  std::atomic<float> smoothedWorldMs;
+  std::atomic<bool> nativeOnly;
+  int framesUnderBudget;
+  int cooldownFrames;
+  std::optional<sf::RenderTexture> target;
+  sf::Vector2u targetSize;
+  std::optional<GpuTimer> gpuTimer;  // created in the target's context
+  mutable std::mutex decisionMutex;
+  std::string lastDecision;
+
+  bool ensureTarget(sf::Vector2u windowSize);
+  std::optional<float> drawWorld(const RenderList& list, sf::FloatRect viewport,
+                                 const sf::ContextSettings& settings, size_t& drawCalls);
+  void adjust(float worldMs);
+
+ public:
+  ResolutionScaler(float minScale = 0.5f, float maxScale = 1.0f,
+                   float budgetMs = 8.0f);
+
+  // Draws `list` into `window` and returns the number of draw calls.
+  size_t render(const RenderList& list, sf::RenderWindow& window);
+  // Frees the GL objects. Call on the thread that owns the context, before
+  // the window closes.
+  void releaseGpuResources();
+
+  bool isEnabled() const;
+  // Upper bound on the scale imposed by the frame budget governor.
+  void setMaxScaleCap(float cap);
+
+  float getScale() const;
+  float getMinScale() const;
+  float getMaxScale() const;
+  float getSmoothedWorldMs() const;
+  std::string describe() const;
+};
+
+#endif  // RESOLUTIONSCALER_H
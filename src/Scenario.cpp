@@ -0,0 +1,301 @@
+#include "Scenario.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "Enemy.h"
+
+namespace {
+const float DEG_TO_RAD = 3.14159265f / 180.0f;
+
+bool parseFormation(const std::string& name, Formation& formation) {
+  if (name == "ring") {
+    formation = Formation::Ring;
+  } else if (name == "line") {
+    formation = Formation::Line;
+  } else if (name == "grid") {
+    formation = Formation::Grid;
+  } else if (name == "cluster") {
+    formation = Formation::Cluster;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool parseFire(const std::string& name, FirePattern& fire) {
+  if (name == "none") {
+    fire = FirePattern::None;
+  } else if (name == "forward") {
+    fire = FirePattern::Forward;
+  } else if (name == "nearest") {
+    fire = FirePattern::Nearest;
+  } else if (name == "sweep") {
+    fire = FirePattern::Sweep;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool parseFloat(const std::string& value, float& out) {
+  char* end = nullptr;
+  out = std::strtof(value.c_str(), &end);
+  return end != value.c_str() && *end == '\0';
+}
+
+bool applyWaveField(ScenarioWave& wave, const std::string& key, const std::string& value) {
+  if (key == "offset") {
+    return std::sscanf(value.c_str(), "%f,%f", &wave.offset.x, &wave.offset.y) == 2;
+  }
+  if (key == "distance") {
+    return parseFloat(value, wave.distance);
+  }
+  if (key == "spacing") {
+    return parseFloat(value, wave.spacing);
+  }
+  if (key == "angle") {
+    return parseFloat(value, wave.angle);
+  }
+  return false;
+}
+}  // namespace
+
+std::string ScenarioDefinition::resolvePath(const std::string& nameOrPath) {
+  if (std::ifstream(nameOrPath).good() ||
+      nameOrPath.find_first_of("/\\.") != std::string::npos) {
+    return nameOrPath;
+  }
+  return "scenarios/" + nameOrPath + ".txt";
+}
+
+ScenarioDefinition ScenarioDefinition::load(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("Cannot open scenario " + path);
+  }
+
+  ScenarioDefinition definition;
+  definition.name = path;
+  std::vector<std::string> waveArchetypes;
+  std::vector<int> waveLines;
+  std::string line;
+  int lineNumber = 0;
+
+  auto fail = [&](const std::string& what) {
+    return std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + what);
+  };
+
+  while (std::getline(in, line)) {
+    lineNumber++;
+    std::istringstream tokens(line.substr(0, line.find('#')));
+    std::string keyword;
+    if (!(tokens >> keyword)) {
+      continue;
+    }
+
+    if (keyword == "name") {
+      std::getline(tokens >> std::ws, definition.name);
+    } else if (keyword == "seed") {
+      if (!(tokens >> definition.seed)) throw fail("expected: seed <n>");
+    } else if (keyword == "duration") {
+      if (!(tokens >> definition.duration) || definition.duration <= 0.0f) {
+        throw fail("expected: duration <seconds>");
+      }
+    } else if (keyword == "archetype") {
+      ScenarioArchetype archetype;
+      if (!(tokens >> archetype.name)) throw fail("expected: archetype <name> ...");
+      std::string field;
+      while (tokens >> field) {
+        size_t equals = field.find('=');
+        std::string key = field.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : field.substr(equals + 1);
+        if (key == "sprite" && !value.empty()) {
+          archetype.sprite = std::atoi(value.c_str());
+        } else if (key == "pattern" && !value.empty()) {
+          archetype.pattern = value;
+        } else {
+          throw fail("bad archetype field '" + field + "'");
+        }
+      }
+      definition.archetypes.push_back(archetype);
+    } else if (keyword == "wave") {
+      ScenarioWave wave;
+      std::string archetype, formation;
+      if (!(tokens >> wave.time >> wave.count >> archetype >> formation) || wave.count < 1) {
+        throw fail("expected: wave <time> <count> <archetype> <formation> ...");
+      }
+      if (!parseFormation(formation, wave.formation)) {
+        throw fail("unknown formation '" + formation + "'");
+      }
+      std::string field;
+      while (tokens >> field) {
+        size_t equals = field.find('=');
+        if (equals == std::string::npos ||
+            !applyWaveField(wave, field.substr(0, equals), field.substr(equals + 1))) {
+          throw fail("bad wave field '" + field + "'");
+        }
+      }
+      definition.waves.push_back(wave);
+      waveArchetypes.push_back(archetype);
+      waveLines.push_back(lineNumber);
+    } else if (keyword == "waypoint") {
+      sf::Vector2f point;
+      if (!(tokens >> point.x >> point.y)) throw fail("expected: waypoint <x> <y>");
+      definition.waypoints.push_back(point);
+    } else if (keyword == "path") {
+      std::string mode;
+      tokens >> mode;
+      if (mode != "once" && mode != "loop") throw fail("expected: path <once|loop>");
+      definition.loopPath = mode == "loop";
+    } else if (keyword == "fire") {
+      std::string mode;
+      if (!(tokens >> mode) || !parseFire(mode, definition.fire)) {
+        throw fail("expected: fire <none|forward|nearest|sweep> [rate]");
+      }
+      tokens >> definition.sweepRate;
+    } else {
+      throw fail("unknown statement '" + keyword + "'");
+    }
+  }
+
+  // Archetypes may be declared after the waves that use them.
+  for (size_t i = 0; i < definition.waves.size(); i++) {
+    auto it = std::find_if(definition.archetypes.begin(), definition.archetypes.end(),
+                           [&](const ScenarioArchetype& a) { return a.name == waveArchetypes[i]; });
+    if (it == definition.archetypes.end()) {
+      lineNumber = waveLines[i];
+      throw fail("unknown archetype '" + waveArchetypes[i] + "'");
+    }
+    definition.waves[i].archetype = static_cast<size_t>(it - definition.archetypes.begin());
+  }
+  std::stable_sort(definition.waves.begin(), definition.waves.end(),
+                   [](const ScenarioWave& a, const ScenarioWave& b) { return a.time < b.time; });
+  return definition;
+}
+
+ScenarioRunner::ScenarioRunner(ScenarioDefinition definition, sf::Vector2f origin)
+    : definition(std::move(definition)),
+      randomEngine(this->definition.seed),
+      origin(origin),
+      elapsed(0.0f),
+      nextWave(0),
+      nextWaypoint(0),
+      sweepAngle(0.0f),
+      lastMove(0.0f, -1.0f),
+      deaths(0),
+      peakEnemies(0),
+      peakBullets(0) {}
+
+const ScenarioDefinition& ScenarioRunner::getDefinition() const { return definition; }
+
+PlayerInput ScenarioRunner::nextInput(const Player& player,
+                                      const std::vector<Enemy*>& enemies) {
+  PlayerInput input;
+  sf::Vector2f playerPos = player.getPos();
+
+  // Head for the current waypoint; close enough counts as reached.
+  const float arriveDistance = 10.0f;
+  if (nextWaypoint < definition.waypoints.size()) {
+    sf::Vector2f toTarget = origin + definition.waypoints[nextWaypoint] - playerPos;
+    float length = std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y);
+    if (length < arriveDistance) {
+      nextWaypoint++;
+      if (nextWaypoint == definition.waypoints.size() && definition.loopPath) {
+        nextWaypoint = 0;
+      }
+    } else {
+      input.move = toTarget / length;
+      lastMove = input.move;
+    }
+  }
+
+  switch (definition.fire) {
+    case FirePattern::None:
+    case FirePattern::Forward:
+      input.aimTarget = playerPos + lastMove;
+      break;
+    case FirePattern::Sweep:
+      input.aimTarget = playerPos + sf::Vector2f(std::cos(sweepAngle * DEG_TO_RAD),
+                                                 std::sin(sweepAngle * DEG_TO_RAD));
+      break;
+    case FirePattern::Nearest: {
+      input.aimTarget = playerPos + lastMove;
+      float nearestSq = -1.0f;
+      for (const Enemy* enemy : enemies) {
+        sf::Vector2f offset = enemy->getPosition() - playerPos;
+        float distSq = offset.x * offset.x + offset.y * offset.y;
+        if (nearestSq < 0.0f || distSq < nearestSq) {
+          nearestSq = distSq;
+          input.aimTarget = enemy->getPosition();
+        }
+      }
+      break;
+    }
+  }
+  input.fire = definition.fire != FirePattern::None;
+  return input;
+}
+
+void ScenarioRunner::spawnDueWaves(sf::Vector2f playerPos, const SpawnFn& spawn) {
+  while (nextWave < definition.waves.size() && definition.waves[nextWave].time <= elapsed) {
+    const ScenarioWave& wave = definition.waves[nextWave++];
+    const ScenarioArchetype& archetype = definition.archetypes[wave.archetype];
+    sf::Vector2f center = playerPos + wave.offset;
+    float angle = wave.angle * DEG_TO_RAD;
+    sf::Vector2f along(std::cos(angle), std::sin(angle));
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(wave.count))));
+
+    for (int i = 0; i < wave.count; i++) {
+      sf::Vector2f position = center;
+      switch (wave.formation) {
+        case Formation::Ring: {
+          float a = angle + 2.0f * 3.14159265f * i / wave.count;
+          position += sf::Vector2f(std::cos(a), std::sin(a)) * wave.distance;
+          break;
+        }
+        case Formation::Line:
+          position += along * (wave.spacing * (i - (wave.count - 1) / 2.0f));
+          break;
+        case Formation::Grid:
+          position += sf::Vector2f(wave.spacing * (i % columns - (columns - 1) / 2.0f),
+                                   wave.spacing * (i / columns - (columns - 1) / 2.0f));
+          break;
+        case Formation::Cluster: {
+          std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+          float a = 2.0f * 3.14159265f * unit(randomEngine);
+          float r = wave.distance * std::sqrt(unit(randomEngine));
+          position += sf::Vector2f(std::cos(a), std::sin(a)) * r;
+          break;
+        }
+      }
+      spawn(position, archetype);
+    }
+  }
+}
+
+void ScenarioRunner::advance(float dt, size_t enemyCount, size_t bulletCount) {
+  elapsed += dt;
+  sweepAngle = std::fmod(sweepAngle + definition.sweepRate * dt, 360.0f);
+  peakEnemies = std::max(peakEnemies, enemyCount);
+  peakBullets = std::max(peakBullets, bulletCount);
+}
+
+void ScenarioRunner::recordDeath() { deaths++; }
+
+bool ScenarioRunner::isFinished() const { return elapsed >= definition.duration; }
+
+void ScenarioRunner::report(std::ostream& log, double wallSeconds,
+                            std::uint64_t frames) const {
+  log << "[scenario] " << definition.name << ": " << frames << " frames, "
+      << elapsed << " s simulated in " << wallSeconds << " s wall ("
+      << (wallSeconds > 0.0 ? frames / wallSeconds : 0.0) << " frames/s), "
+      << nextWave << "/" << definition.waves.size() << " waves, peak enemies "
+      << peakEnemies << ", peak bullets " << peakBullets << ", player deaths "
+      << deaths << std::endl;
+}
@@ -0,0 +1,106 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Player.h"
+
+class Enemy;
+
+enum class Formation : std::uint8_t {
+  Ring,     // evenly around the centre at `distance`
+  Line,     // `spacing` apart along `angle`, centred on the centre
+  Grid,     // square grid `spacing` apart, centred on the centre
+  Cluster,  // uniformly random within `distance` of the centre
+};
+
+enum class FirePattern : std::uint8_t {
+  None,
+  Forward,  // aim where the player is moving
+  Nearest,  // aim at the closest enemy
+  Sweep,    // rotate the aim at `sweepRate` degrees per second
+};
+
+struct ScenarioArchetype {
+  std::string name;
+  int sprite = 0;
+  std::string pattern;  // bullet pattern name, empty picks one at random
+};
+
+struct ScenarioWave {
+  float time = 0.0f;
+  int count = 1;
+  size_t archetype = 0;
+  Formation formation = Formation::Ring;
+  sf::Vector2f offset;  // centre relative to the player
+  float distance = 250.0f;
+  float spacing = 30.0f;
+  float angle = 0.0f;
+};
+
+// A reproducible test level, parsed from a text file. One statement per
+// line, '#' starts a comment:
+//   name <text>                 seed <n>                  duration <seconds>
+//   archetype <name> [sprite=<0-2>] [pattern=<bullet pattern>]
+//   wave <time> <count> <archetype> <ring|line|grid|cluster>
+//        [distance=<d>] [spacing=<s>] [angle=<deg>] [offset=<x>,<y>]
+//   waypoint <x> <y>            path relative to the start position
+//   path <once|loop>
+//   fire <none|forward|nearest|sweep> [degrees per second]
+struct ScenarioDefinition {
+  std::string name;
+  std::uint32_t seed = 1;
+  float duration = 60.0f;
+  std::vector<ScenarioArchetype> archetypes;
+  std::vector<ScenarioWave> waves;  // sorted by time
+  std::vector<sf::Vector2f> waypoints;
+  bool loopPath = false;
+  FirePattern fire = FirePattern::None;
+  float sweepRate = 90.0f;
+
+  // Throws std::runtime_error naming the file and line on bad input.
+  static ScenarioDefinition load(const std::string& path);
+  // "swarm-5k" -> "scenarios/swarm-5k.txt" unless a file by that name exists.
+  static std::string resolvePath(const std::string& nameOrPath);
+};
+
+// Plays a scenario at a fixed timestep: drives the player and releases
+// waves on schedule. Game owns the enemies; spawning goes through a callback.
+class ScenarioRunner {
+ public:
+  using SpawnFn = std::function<void(sf::Vector2f position, const ScenarioArchetype& archetype)>;
+
+ private:
+  ScenarioDefinition definition;
+  std::mt19937 randomEngine;
+  sf::Vector2f origin;
+  float elapsed;
+  size_t nextWave;
+  size_t nextWaypoint;
+  float sweepAngle;
+  sf::Vector2f lastMove;
+  int deaths;
+  size_t peakEnemies;
+  size_t peakBullets;
+
+ public:
+  static constexpr float FIXED_DT = 1.0f / 60.0f;
+
+  ScenarioRunner(ScenarioDefinition definition, sf::Vector2f origin);
+
+  const ScenarioDefinition& getDefinition() const;
+  PlayerInput nextInput(const Player& player, const std::vector<Enemy*>& enemies);
+  void spawnDueWaves(sf::Vector2f playerPos, const SpawnFn& spawn);
+  void advance(float dt, size_t enemyCount, size_t bulletCount);
+  void recordDeath();
+  bool isFinished() const;
+
+  void report(std::ostream& log, double wallSeconds, std::uint64_t frames) const;
+};
+
+#endif  // SCENARIO_H
@@ -0,0 +1,174 @@
+#include "ScriptedClient.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+// Render this many ticks behind the newest snapshot so there is
+// (almost) always a pair to interpolate between.
+constexpr float kInterpolationDelayTicks = 2.0f;
+constexpr size_t kBufferedSnapshots = 8;
+}  // namespace
+
+ScriptedClient::ScriptedClient(int index, unsigned short serverPort, int tickRate)
+    : serverPort(serverPort),
+      index(index),
+      tickRate(tickRate > 0 ? tickRate : DEFAULT_TICK_RATE),
+      sequence(0),
+      ackTick(0),
+      shipId(0),
+      scriptTime(0.0f),
+      bytesReceived(0),
+      snapshotsDecoded(0),
+      decodeFailures(0),
+      framesInterpolated(0) {
+  if (socket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) !=
+      sf::Socket::Status::Done) {
+    throw std::runtime_error("Failed to bind client socket");
+  }
+  socket.setBlocking(false);
+}
+
+void ScriptedClient::update(float dt) {
+  scriptTime += dt;
+  sendInput(nullptr);
+  receiveSnapshots();
+}
+
+void ScriptedClient::update(float dt, const NetInput& input) {
+  scriptTime += dt;
+  sendInput(&input);
+  receiveSnapshots();
+}
+
+void ScriptedClient::sendInput(const NetInput* manual) {
+  ByteWriter writer;
+  if (ackTick == 0) {
+    writer.writeU8(static_cast<std::uint8_t>(MessageType::Hello));
+  } else if (manual) {
+    writer.writeU8(static_cast<std::uint8_t>(MessageType::Input));
+    writer.writeU32(++sequence);
+    writer.writeU32(ackTick);
+    writer.writeU8(static_cast<std::uint8_t>(manual->moveX));
+    writer.writeU8(static_cast<std::uint8_t>(manual->moveY));
+    writer.writeU8(manual->aim);
+    writer.writeU8(manual->fire);
+  } else {
+    // Each bot flies its own phase-shifted figure eight while sweeping its
+    // aim and firing in bursts.
+    float phase = scriptTime * 0.8f + index * 1.3f;
+    float aimTurns = scriptTime * 0.25f + index * 0.1f;
+    writer.writeU8(static_cast<std::uint8_t>(MessageType::Input));
+    writer.writeU32(++sequence);
+    writer.writeU32(ackTick);
+    writer.writeU8(static_cast<std::uint8_t>(std::cos(phase) > 0.0f ? 1 : -1));
+    writer.writeU8(static_cast<std::uint8_t>(std::sin(2.0f * phase) > 0.0f ? 1 : -1));
+    writer.writeU8(static_cast<std::uint8_t>(
+        static_cast<int>((aimTurns - std::floor(aimTurns)) * 256.0f) & 0xff));
+    writer.writeU8(std::fmod(scriptTime, 2.0f) < 1.5f ? 1 : 0);
+  }
+  (void)socket.send(writer.data(), writer.size(), sf::IpAddress::LocalHost,
+                    serverPort);
+}
+
+void ScriptedClient::receiveSnapshots() {
+  static std::uint8_t packet[sf::UdpSocket::MaxDatagramSize];
+  std::size_t received = 0;
+  std::optional<sf::IpAddress> sender;
+  unsigned short senderPort = 0;
+
+  while (socket.receive(packet, sizeof(packet), received, sender, senderPort) ==
+         sf::Socket::Status::Done) {
+    bytesReceived += received;
+
+    ByteReader reader(packet, received);
+    if (static_cast<MessageType>(reader.readU8()) != MessageType::Snapshot) {
+      continue;
+    }
+    shipId = reader.readVarUInt();
+
+    WorldSnapshot snapshot;
+    if (!SnapshotCodec::decode(reader, history, snapshot)) {
+      decodeFailures++;
+      continue;
+    }
+    if (snapshot.tick <= ackTick) {
+      continue;  // reordered or duplicate
+    }
+
+    snapshotsDecoded++;
+    history.store(snapshot);
+    ackTick = snapshot.tick;
+    buffer.push_back(std::move(snapshot));
+    if (buffer.size() > kBufferedSnapshots) {
+      buffer.pop_front();
+    }
+    sinceLatest.restart();
+  }
+}
+
+const std::vector<InterpolatedEntity>& ScriptedClient::interpolate() {
+  interpolated.clear();
+  if (buffer.size() < 2) {
+    return interpolated;
+  }
+
+  float renderTick = buffer.back().tick +
+                     sinceLatest.getElapsedTime().asSeconds() * tickRate -
+                     kInterpolationDelayTicks;
+
+  // Find the pair of snapshots straddling the render time.
+  size_t next = 1;
+  while (next < buffer.size() - 1 && buffer[next].tick < renderTick) {
+    next++;
+  }
+  const WorldSnapshot& from = buffer[next - 1];
+  const WorldSnapshot& to = buffer[next];
+  float t = (renderTick - from.tick) / static_cast<float>(to.tick - from.tick);
+  if (t < 0.0f) t = 0.0f;
+  if (t > 1.0f) t = 1.0f;
+
+  // Entities are sorted by id in both snapshots; entities that only exist in
+  // the newer one snap to their new position.
+  size_t i = 0;
+  for (const NetEntity& target : to.entities) {
+    while (i < from.entities.size() && from.entities[i].id < target.id) {
+      i++;
+    }
+    float x = target.x / POSITION_QUANTUM;
+    float y = target.y / POSITION_QUANTUM;
+    if (i < from.entities.size() && from.entities[i].id == target.id) {
+      float fromX = from.entities[i].x / POSITION_QUANTUM;
+      float fromY = from.entities[i].y / POSITION_QUANTUM;
+      x = fromX + (x - fromX) * t;
+      y = fromY + (y - fromY) * t;
+    }
+    interpolated.push_back({target.id, target.type, x, y});
+  }
+
+  framesInterpolated++;
+  return interpolated;
+}
+
+void ScriptedClient::disconnect() {
+  ByteWriter writer;
+  writer.writeU8(static_cast<std::uint8_t>(MessageType::Goodbye));
+  (void)socket.send(writer.data(), writer.size(), sf::IpAddress::LocalHost,
+                    serverPort);
+}
+
+std::uint32_t ScriptedClient::getShipId() const { return shipId; }
+
+void ScriptedClient::printStats(float seconds) const {
+  if (seconds <= 0.0f) {
+    return;
+  }
+  std::printf(
+      "[client %d] ship %u | %llu snapshots (%llu failed) | %.1f KB/s in | "
+      "%llu frames interpolated\n",
+      index, shipId, static_cast<unsigned long long>(snapshotsDecoded),
+      static_cast<unsigned long long>(decodeFailures),
+      bytesReceived / 1024.0 / seconds,
+      static_cast<unsigned long long>(framesInterpolated));
+}
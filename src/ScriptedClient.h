@@ -0,0 +1,60 @@
+#ifndef SCRIPTEDCLIENT_H
+#define SCRIPTEDCLIENT_H
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "NetProtocol.h"
+#include "SnapshotCodec.h"
+
+// Entity state reconstructed on the client between two server snapshots.
+struct InterpolatedEntity {
+  std::uint32_t id;
+  std::uint8_t type;
+  float x;
+  float y;
+};
+
+// Client driven by a deterministic input script (or by a player through the
+// update overload). It decodes delta snapshots, interpolates entities and
+// keeps per-client traffic counters.
+class ScriptedClient {
+ private:
+  sf::UdpSocket socket;
+  unsigned short serverPort;
+  int index;
+  int tickRate;
+  SnapshotHistory history;
+  std::deque<WorldSnapshot> buffer;
+  sf::Clock sinceLatest;
+  std::uint32_t sequence;
+  std::uint32_t ackTick;
+  std::uint32_t shipId;
+  float scriptTime;
+  std::vector<InterpolatedEntity> interpolated;
+
+  std::uint64_t bytesReceived;
+  std::uint64_t snapshotsDecoded;
+  std::uint64_t decodeFailures;
+  std::uint64_t framesInterpolated;
+
+  void sendInput(const NetInput* manual);
+  void receiveSnapshots();
+
+ public:
+  ScriptedClient(int index, unsigned short serverPort = DEFAULT_SERVER_PORT,
+                 int tickRate = DEFAULT_TICK_RATE);
+
+  // Advance the script by dt, send input and consume pending snapshots.
+  void update(float dt);
+  // Same, but send the given movement, aim and fire instead of the script.
+  void update(float dt, const NetInput& input);
+  // Rebuild entity positions at the interpolated render time.
+  const std::vector<InterpolatedEntity>& interpolate();
+  void disconnect();
+  std::uint32_t getShipId() const;
+  void printStats(float seconds) const;
+};
+
+#endif  // SCRIPTEDCLIENT_H
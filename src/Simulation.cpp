@@ -0,0 +1,430 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "Projectile.h"
+#include "WorldFile.h"
+
+Simulation::Simulation(std::uint32_t seed, ThreadPool* threadPool)
+    : nextPlayerId(1),
+      nextEnemyId(1),
+      nextProjectileId(1),
+      tick(0),
+      knobs(FrameGovernor().getKnobs()),
+      randomSpawning(true),
+      worldFile(nullptr),
+      enemySpawnTimer(0.0f),
+      enemySpawnInterval(1.0f),
+      randomEngine(seed),
+      angleDist(0.0f, 2.0f * 3.14159f),
+      distanceDist(200.0f, 300.0f),
+      spriteDist(0, 2),
+      bulletPatterns(BulletPatternLibrary::builtin()),
+      collisionSystem(threadPool) {}
+
+Simulation::~Simulation() {
+  for (PlayerSlot& slot : players) {
+    delete slot.player;
+  }
+  for (Enemy* enemy : enemies) {
+    delete enemy;
+  }
+}
+
+sf::View Simulation::viewFor(sf::Vector2f center) {
+  return sf::View(center, {VIEW_WIDTH, VIEW_HEIGHT});
+}
+
+void Simulation::seed(std::uint32_t seed) { randomEngine.seed(seed); }
+
+void Simulation::setKnobs(const FrameBudgetKnobs& knobs) { this->knobs = knobs; }
+
+void Simulation::setWorldFile(const WorldFile* worldFile) { this->worldFile = worldFile; }
+
+void Simulation::setBulletPatterns(BulletPatternLibrary patterns) {
+  bulletPatterns = std::move(patterns);
+}
+
+void Simulation::setRandomSpawning(bool enabled) { randomSpawning = enabled; }
+
+std::uint32_t Simulation::addPlayer(sf::Vector2f position) {
+  PlayerSlot slot = {};
+  slot.id = nextPlayerId++;
+  slot.player = new Player(position);
+  slot.input.aimTarget = position;
+  players.push_back(slot);
+  return slot.id;
+}
+
+void Simulation::removePlayer(std::uint32_t id) {
+  for (auto it = players.begin(); it != players.end(); ++it) {
+    if (it->id == id) {
+      delete it->player;
+      players.erase(it);
+      return;
+    }
+  }
+}
+
+void Simulation::setInput(std::uint32_t id, const PlayerInput& input) {
+  if (PlayerSlot* slot = findSlot(id)) {
+    slot->input = input;
+  }
+}
+
+Simulation::PlayerSlot* Simulation::findSlot(std::uint32_t id) {
+  for (PlayerSlot& slot : players) {
+    if (slot.id == id) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+const Simulation::PlayerSlot* Simulation::findSlot(std::uint32_t id) const {
+  for (const PlayerSlot& slot : players) {
+    if (slot.id == id) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+const Player* Simulation::nearestPlayer(sf::Vector2f position) const {
+  const Player* nearest = nullptr;
+  float nearestSq = 0.0f;
+  for (const PlayerSlot& slot : players) {
+    sf::Vector2f offset = slot.player->getPos() - position;
+    float distanceSq = offset.x * offset.x + offset.y * offset.y;
+    if (!nearest || distanceSq < nearestSq) {
+      nearest = slot.player;
+      nearestSq = distanceSq;
+    }
+  }
+  return nearest;
+}
+
+const SimulationStepStats& Simulation::step(float dt) {
+  stats = SimulationStepStats();
+  if (players.empty()) {
+    return stats;
+  }
+
+  sf::Clock phaseClock;
+  updatePlayers(dt);
+  updateWorldEntities(dt);
+  stats.playerMicros = phaseClock.restart().asMicroseconds();
+
+  if (randomSpawning) {
+    enemySpawnTimer += dt;
+    if (enemySpawnTimer >= enemySpawnInterval * knobs.spawnIntervalScale) {
+      spawnEnemy();
+      enemySpawnTimer = 0.0f;
+    }
+  }
+  updateEnemies(dt);
+  updateBullets(dt);
+  stats.enemyMicros = phaseClock.restart().asMicroseconds();
+
+  checkCollisions();
+  assignProjectileIds();
+  stats.collisionMicros = phaseClock.restart().asMicroseconds();
+
+  tick++;
+  return stats;
+}
+
+void Simulation::updatePlayers(float dt) {
+  for (PlayerSlot& slot : players) {
+    Player* player = slot.player;
+    player->applyInput(slot.input, dt);
+    player->updateProjectiles(dt, viewFor(player->getPos()));
+    player->update();
+  }
+}
+
+void Simulation::spawnEnemy() {
+  if (enemies.size() >= knobs.maxEnemies) {
+    return;
+  }
+
+  float angle = angleDist(randomEngine);
+  float distance = distanceDist(randomEngine);
+
+  // Spread the pressure across everyone connected.
+  std::uniform_int_distribution<size_t> playerDist(0, players.size() - 1);
+  sf::Vector2f playerPos = players[playerDist(randomEngine)].player->getPos();
+  sf::Vector2f enemyPos;
+  enemyPos.x = playerPos.x + std::cos(angle) * distance;
+  enemyPos.y = playerPos.y + std::sin(angle) * distance;
+
+  spawnEnemyAt(enemyPos, spriteDist(randomEngine));
+}
+
+void Simulation::spawnEnemyAt(sf::Vector2f position, int spriteType) {
+  if (enemies.size() >= knobs.maxEnemies) {
+    return;
+  }
+  addEnemy(position, spriteType, nullptr);
+  stats.enemiesSpawned++;
+}
+
+void Simulation::addEnemy(sf::Vector2f position, int spriteType,
+                          const BulletPattern* pattern) {
+  if (!pattern) {
+    std::uniform_int_distribution<size_t> patternDist(0, bulletPatterns.size() - 1);
+    pattern = &bulletPatterns.get(patternDist(randomEngine));
+  }
+  Enemy* enemy = new Enemy(position, spriteType, pattern);
+  enemy->setId(nextEnemyId++);
+  enemies.push_back(enemy);
+}
+
+void Simulation::updateWorldEntities(float dt) {
+  if (!worldFile) {
+    return;
+  }
+
+  // Every chunk within the load distance of any player, each visited once
+  // so spawner timers advance once per step however many players are near.
+  activeChunks.clear();
+  int radius = knobs.chunkLoadDistance;
+  for (const PlayerSlot& slot : players) {
+    sf::Vector2f pos = slot.player->getPos();
+    int centerX = static_cast<int>(std::floor(pos.x / WORLD_CHUNK_SIZE));
+    int centerY = static_cast<int>(std::floor(pos.y / WORLD_CHUNK_SIZE));
+    for (int x = -radius; x <= radius; ++x) {
+      for (int y = -radius; y <= radius; ++y) {
+        activeChunks.push_back({centerX + x, centerY + y});
+      }
+    }
+  }
+  std::sort(activeChunks.begin(), activeChunks.end(),
+            [](const sf::Vector2i& a, const sf::Vector2i& b) {
+              return a.x != b.x ? a.x < b.x : a.y < b.y;
+            });
+  activeChunks.erase(std::unique(activeChunks.begin(), activeChunks.end()),
+                     activeChunks.end());
+
+  for (const sf::Vector2i& chunk : activeChunks) {
+    WorldEntitySpan span = worldFile->getChunk(chunk.x, chunk.y);
+    sf::Vector2f origin(static_cast<float>(chunk.x * WORLD_CHUNK_SIZE),
+                        static_cast<float>(chunk.y * WORLD_CHUNK_SIZE));
+    for (std::uint32_t i = 0; i < span.count; i++) {
+      const WorldEntity& entity = span.entities[i];
+      std::uint32_t id = span.firstIndex + i;
+      sf::Vector2f position = origin + sf::Vector2f(entity.x, entity.y);
+
+      auto touches = [&](const Player* player) {
+        sf::Vector2f offset = player->getPos() - position;
+        return offset.x * offset.x + offset.y * offset.y <= entity.radius * entity.radius;
+      };
+
+      switch (static_cast<WorldEntityType>(entity.type)) {
+        case WorldEntityType::Hazard:
+          for (PlayerSlot& slot : players) {
+            if (touches(slot.player)) {
+              slot.player->takeDamage(entity.value * dt);
+            }
+          }
+          break;
+        case WorldEntityType::Pickup:
+          for (PlayerSlot& slot : players) {
+            if (touches(slot.player) && collectedPickups.insert(id).second) {
+              slot.player->heal(entity.value);
+            }
+          }
+          break;
+        case WorldEntityType::Spawner: {
+          float& timer = spawnerTimers[id];
+          timer += dt;
+          if (timer >= entity.value) {
+            timer = 0.0f;
+            spawnEnemyAt(position, entity.variant);
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+}
+
+void Simulation::updateEnemies(float dt) {
+  // Enemies beyond the AI LOD distance only think every few ticks,
+  // staggered by index so the work is spread evenly.
+  const unsigned long lodStride = 4;
+  float lodDistanceSq = knobs.aiLodDistance * knobs.aiLodDistance;
+  flock.build(enemies);
+
+  // Erasing dead enemies shifts `i`; the flock and the LOD stagger keep the
+  // tick-start order.
+  for (size_t i = 0, flockIndex = 0; i < enemies.size(); i++, flockIndex++) {
+    const Player& target = *nearestPlayer(enemies[i]->getPosition());
+    sf::Vector2f offset = enemies[i]->getPosition() - target.getPos();
+    float distanceSq = offset.x * offset.x + offset.y * offset.y;
+    sf::View view = viewFor(target.getPos());
+
+    if (distanceSq <= lodDistanceSq) {
+      enemies[i]->update(dt, target, view, bullets, flock.steer(flockIndex));
+    } else if ((tick + flockIndex) % lodStride == 0) {
+      enemies[i]->update(dt * lodStride, target, view, bullets, flock.steer(flockIndex));
+    }
+
+    if (enemies[i]->isDead()) {
+      delete enemies[i];
+      enemies.erase(enemies.begin() + i);
+      i--;
+    }
+  }
+}
+
+void Simulation::updateBullets(float dt) {
+  // Keep bullets alive anywhere some player could still see them, using the
+  // same margin Projectile::checkOutOfBounds gives player shots.
+  sf::Vector2f low = players.front().player->getPos();
+  sf::Vector2f high = low;
+  for (const PlayerSlot& slot : players) {
+    sf::Vector2f pos = slot.player->getPos();
+    low = {std::min(low.x, pos.x), std::min(low.y, pos.y)};
+    high = {std::max(high.x, pos.x), std::max(high.y, pos.y)};
+  }
+  sf::Vector2f extent(VIEW_WIDTH / 2.0f + OFFSCREEN_MARGIN,
+                      VIEW_HEIGHT / 2.0f + OFFSCREEN_MARGIN);
+  bullets.update(dt, sf::FloatRect(low - extent, high - low + 2.0f * extent));
+}
+
+void Simulation::assignProjectileIds() {
+  // Shots are created inside Player; give new ones an id once per step.
+  for (PlayerSlot& slot : players) {
+    for (Projectile* projectile : slot.player->getProjectiles()) {
+      if (projectile->getId() == 0) {
+        projectile->setId(nextProjectileId++);
+      }
+    }
+  }
+}
+
+void Simulation::checkCollisions() {
+  for (PlayerSlot& slot : players) {
+    hitEvents.clear();
+    collisionSystem.detect(*slot.player, enemies, bullets, hitEvents);
+    resolveHits(slot);
+  }
+}
+
+void Simulation::resolveHits(PlayerSlot& slot) {
+  Player* player = slot.player;
+  std::sort(hitEvents.begin(), hitEvents.end(),
+            [](const HitEvent& a, const HitEvent& b) {
+              if (a.kind != b.kind) return a.kind < b.kind;
+              if (a.owner != b.owner) return a.owner < b.owner;
+              if (a.target != b.target) return a.target < b.target;
+              return a.source < b.source;
+            });
+
+  // Dense patterns can overlap the player with many bullets at once; only
+  // one of them deals damage per tick, but all of them are spent.
+  bool bulletDamageTaken = false;
+  for (const HitEvent& hit : hitEvents) {
+    switch (hit.kind) {
+      case HitKind::PlayerShotEnemy: {
+        Enemy* enemy = enemies[hit.target];
+        if (!enemy->isDead()) {
+          enemy->takeDamage(hit.damage);
+          if (enemy->isDead()) {
+            slot.enemiesKilled++;
+            stats.enemiesKilled++;
+          }
+        }
+        break;
+      }
+      case HitKind::EnemyShotPlayer:
+        if (!bulletDamageTaken) {
+          player->takeDamage(hit.damage);
+          bulletDamageTaken = true;
+        }
+        break;
+      case HitKind::EnemyRammedPlayer:
+        if (player->canTakeCollisionDamage()) {
+          player->takeDamage(hit.damage);
+        }
+        break;
+    }
+  }
+
+  // Despawn spent projectiles back to front so earlier indices stay valid.
+  despawnScratch.clear();
+  for (const HitEvent& hit : hitEvents) {
+    if (hit.kind == HitKind::PlayerShotEnemy) {
+      despawnScratch.push_back(hit.source);
+    }
+  }
+  std::sort(despawnScratch.rbegin(), despawnScratch.rend());
+  for (size_t projIndex : despawnScratch) {
+    player->removeProjectiles(projIndex);
+  }
+
+  for (const HitEvent& hit : hitEvents) {
+    if (hit.kind == HitKind::EnemyShotPlayer) {
+      bullets.kill(hit.source);
+    }
+  }
+}
+
+void Simulation::reset(sf::Vector2f startPosition) {
+  for (PlayerSlot& slot : players) {
+    delete slot.player;
+    slot.player = new Player(startPosition);
+    slot.input = PlayerInput();
+    slot.input.aimTarget = startPosition;
+    slot.enemiesKilled = 0;
+  }
+
+  for (Enemy* enemy : enemies) {
+    delete enemy;
+  }
+  enemies.clear();
+  bullets.clear();
+  collectedPickups.clear();
+  spawnerTimers.clear();
+  enemySpawnTimer = 0.0f;
+}
+
+Player* Simulation::getPlayer(std::uint32_t id) {
+  PlayerSlot* slot = findSlot(id);
+  return slot ? slot->player : nullptr;
+}
+
+const Player* Simulation::getPlayer(std::uint32_t id) const {
+  const PlayerSlot* slot = findSlot(id);
+  return slot ? slot->player : nullptr;
+}
+
+const std::vector<Simulation::PlayerSlot>& Simulation::getPlayers() const {
+  return players;
+}
+
+size_t Simulation::getEnemiesKilled(std::uint32_t id) const {
+  const PlayerSlot* slot = findSlot(id);
+  return slot ? slot->enemiesKilled : 0;
+}
+
+const std::vector<Enemy*>& Simulation::getEnemies() const { return enemies; }
+
+const BulletPool& Simulation::getBullets() const { return bullets; }
+
+const BulletPatternLibrary& Simulation::getBulletPatterns() const {
+  return bulletPatterns;
+}
+
+const Flock& Simulation::getFlock() const { return flock; }
+
+bool Simulation::isPickupCollected(std::uint32_t index) const {
+  return collectedPickups.count(index) != 0;
+}
+
+unsigned long Simulation::getTick() const { return tick; }
@@ -0,0 +1,141 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "BulletPattern.h"
+#include "BulletPool.h"
+#include "CollisionSystem.h"
+#include "Enemy.h"
+#include "Flocking.h"
+#include "FrameGovernor.h"
+#include "Player.h"
+
+class ThreadPool;
+class WorldFile;
+
+// Counts and phase timings of one Simulation::step(), for metrics.
+struct SimulationStepStats {
+  size_t enemiesSpawned = 0;
+  size_t enemiesKilled = 0;
+  std::int64_t playerMicros = 0;     // player input, projectiles, world entities
+  std::int64_t enemyMicros = 0;      // spawning, enemy AI and bullets
+  std::int64_t collisionMicros = 0;  // detection and resolution
+};
+
+// The authoritative game state and its fixed rules: players, enemies, enemy
+// bullets, authored world entities and hit resolution. The windowed game
+// steps one local player through it; the loopback server steps one player
+// per connected client. Nothing here reads devices or draws.
+class Simulation {
+ public:
+  struct PlayerSlot {
+    std::uint32_t id;
+    Player* player;
+    PlayerInput input;
+    size_t enemiesKilled;
+  };
+
+ private:
+  std::vector<PlayerSlot> players;
+  std::uint32_t nextPlayerId;
+  std::uint32_t nextEnemyId;
+  std::uint32_t nextProjectileId;
+  unsigned long tick;
+  FrameBudgetKnobs knobs;
+  bool randomSpawning;
+  const WorldFile* worldFile;
+
+  // Enemy management
+  std::vector<Enemy*> enemies;
+  Flock flock;
+  float enemySpawnTimer;
+  float enemySpawnInterval;
+  std::mt19937 randomEngine;
+  std::uniform_real_distribution<float> angleDist;
+  std::uniform_real_distribution<float> distanceDist;
+  std::uniform_int_distribution<int> spriteDist;
+
+  // Enemy bullets: patterns from patterns.txt, bullets in one shared pool
+  BulletPatternLibrary bulletPatterns;
+  BulletPool bullets;
+
+  // Runtime state of authored world entities, keyed by file-wide index
+  std::unordered_set<std::uint32_t> collectedPickups;
+  std::unordered_map<std::uint32_t, float> spawnerTimers;
+  std::vector<sf::Vector2i> activeChunks;
+
+  // Collision detection emits hit events; resolution applies them in one batch
+  CollisionSystem collisionSystem;
+  std::vector<HitEvent> hitEvents;
+  std::vector<size_t> despawnScratch;
+
+  SimulationStepStats stats;
+
+  PlayerSlot* findSlot(std::uint32_t id);
+  const PlayerSlot* findSlot(std::uint32_t id) const;
+  const Player* nearestPlayer(sf::Vector2f position) const;
+  void spawnEnemy();
+  void spawnEnemyAt(sf::Vector2f position, int spriteType);
+  void updatePlayers(float dt);
+  void updateWorldEntities(float dt);
+  void updateEnemies(float dt);
+  void updateBullets(float dt);
+  void assignProjectileIds();
+  void checkCollisions();
+  void resolveHits(PlayerSlot& slot);
+
+ public:
+  // The area each player sees; enemies only shoot inside it and shots and
+  // bullets leaving it (plus a margin) are dropped.
+  static constexpr float VIEW_WIDTH = 192.0f;
+  static constexpr float VIEW_HEIGHT = 108.0f;
+  static constexpr float OFFSCREEN_MARGIN = 100.0f;
+
+  explicit Simulation(std::uint32_t seed, ThreadPool* threadPool = nullptr);
+  ~Simulation();
+
+  Simulation(const Simulation&) = delete;
+  Simulation& operator=(const Simulation&) = delete;
+
+  static sf::View viewFor(sf::Vector2f center);
+
+  void seed(std::uint32_t seed);
+  void setKnobs(const FrameBudgetKnobs& knobs);
+  // Spawners, hazards and pickups come from this file; nullptr disables them.
+  void setWorldFile(const WorldFile* worldFile);
+  // Enemies point into the library, so set it before the first spawn.
+  void setBulletPatterns(BulletPatternLibrary patterns);
+  // Off while a scenario drives spawning through addEnemy().
+  void setRandomSpawning(bool enabled);
+
+  std::uint32_t addPlayer(sf::Vector2f position);
+  void removePlayer(std::uint32_t id);
+  // The input is held and applied on every step until replaced.
+  void setInput(std::uint32_t id, const PlayerInput& input);
+
+  // Ignores the enemy cap; `pattern` nullptr picks one at random.
+  void addEnemy(sf::Vector2f position, int spriteType, const BulletPattern* pattern);
+
+  const SimulationStepStats& step(float dt);
+  // Clears enemies, bullets and world entity state and puts every player
+  // back at the start, keeping their ids.
+  void reset(sf::Vector2f startPosition);
+
+  Player* getPlayer(std::uint32_t id);
+  const Player* getPlayer(std::uint32_t id) const;
+  const std::vector<PlayerSlot>& getPlayers() const;
+  size_t getEnemiesKilled(std::uint32_t id) const;
+  const std::vector<Enemy*>& getEnemies() const;
+  const BulletPool& getBullets() const;
+  const BulletPatternLibrary& getBulletPatterns() const;
+  const Flock& getFlock() const;
+  bool isPickupCollected(std::uint32_t index) const;
+  unsigned long getTick() const;
+};
+
+#endif  // SIMULATION_H
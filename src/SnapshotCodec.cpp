@@ -0,0 +1,218 @@
+#include "SnapshotCodec.h"
+
+namespace {
+enum FieldMask : std::uint8_t {
+  FieldNew = 1 << 0,
+  FieldX = 1 << 1,
+  FieldY = 1 << 2,
+  FieldRotation = 1 << 3,
+  FieldHealth = 1 << 4,
+};
+
+const NetEntity kZeroEntity = {0, 0, 0, 0, 0, 0};
+
+std::uint8_t diffMask(const NetEntity& current, const NetEntity& base) {
+  std::uint8_t mask = 0;
+  if (current.x != base.x) mask |= FieldX;
+  if (current.y != base.y) mask |= FieldY;
+  if (current.rotation != base.rotation) mask |= FieldRotation;
+  if (current.health != base.health) mask |= FieldHealth;
+  return mask;
+}
+
+// Ids are written as the gap from the previous id in the same list, which
+// is sorted, so dense ids cost one byte whatever their magnitude.
+void writeEntity(const NetEntity& current, const NetEntity& base,
+                 std::uint8_t mask, std::uint32_t previousId, ByteWriter& out) {
+  out.writeVarUInt(current.id - previousId);
+  out.writeU8(mask);
+  if (mask & FieldNew) out.writeU8(current.type);
+  if (mask & FieldX) out.writeVarInt(current.x - base.x);
+  if (mask & FieldY) out.writeVarInt(current.y - base.y);
+  if (mask & FieldRotation) out.writeU8(current.rotation);
+  if (mask & FieldHealth) out.writeU8(current.health);
+}
+// Reads the next gap-encoded id of a sorted list. Ids must strictly
+// increase without wrapping.
+bool nextId(ByteReader& in, bool first, std::uint32_t& id) {
+  std::uint32_t gap = in.readVarUInt();
+  if (!in.ok() || (!first && gap == 0) || gap > UINT32_MAX - id) {
+    return false;
+  }
+  id += gap;
+  return true;
+}
+}  // namespace
+
+SnapshotHistory::SnapshotHistory() : slots(SNAPSHOT_HISTORY) {}
+
+void SnapshotHistory::store(const WorldSnapshot& snapshot) {
+  slots[snapshot.tick % SNAPSHOT_HISTORY] = snapshot;
+}
+
+const WorldSnapshot* SnapshotHistory::find(std::uint32_t tick) const {
+  const WorldSnapshot& slot = slots[tick % SNAPSHOT_HISTORY];
+  if (tick == 0 || slot.tick != tick) {
+    return nullptr;
+  }
+  return &slot;
+}
+
+std::size_t SnapshotCodec::encode(const WorldSnapshot& current,
+                                  const WorldSnapshot* baseline,
+                                  ByteWriter& out) {
+  static const std::vector<NetEntity> empty;
+  const std::vector<NetEntity>& base = baseline ? baseline->entities : empty;
+
+  out.writeU32(current.tick);
+  out.writeU32(baseline ? baseline->tick : 0);
+
+  // Both lists are sorted by id, so one merge pass finds removed, changed
+  // and new entities.
+  std::vector<std::uint32_t> removed;
+  std::size_t changedCount = 0;
+  std::uint32_t previousId = 0;
+  ByteWriter records;
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < current.entities.size() || j < base.size()) {
+    if (j >= base.size() ||
+        (i < current.entities.size() && current.entities[i].id < base[j].id)) {
+      writeEntity(current.entities[i], kZeroEntity,
+                  FieldNew | FieldX | FieldY | FieldRotation | FieldHealth,
+                  previousId, records);
+      previousId = current.entities[i].id;
+      changedCount++;
+      i++;
+    } else if (i >= current.entities.size() ||
+               base[j].id < current.entities[i].id) {
+      removed.push_back(base[j].id);
+      j++;
+    } else if (current.entities[i].type != base[j].type) {
+      // The id was recycled for a different entity inside the baseline
+      // window; send it whole so the client replaces the old one.
+      writeEntity(current.entities[i], kZeroEntity,
+                  FieldNew | FieldX | FieldY | FieldRotation | FieldHealth,
+                  previousId, records);
+      previousId = current.entities[i].id;
+      changedCount++;
+      i++;
+      j++;
+    } else {
+      std::uint8_t mask = diffMask(current.entities[i], base[j]);
+      if (mask != 0) {
+        writeEntity(current.entities[i], base[j], mask, previousId, records);
+        previousId = current.entities[i].id;
+        changedCount++;
+      }
+      i++;
+      j++;
+    }
+  }
+
+  out.writeVarUInt(static_cast<std::uint32_t>(removed.size()));
+  previousId = 0;
+  for (std::uint32_t id : removed) {
+    out.writeVarUInt(id - previousId);
+    previousId = id;
+  }
+  out.writeVarUInt(static_cast<std::uint32_t>(changedCount));
+  for (size_t k = 0; k < records.size(); k++) {
+    out.writeU8(records.data()[k]);
+  }
+  return changedCount;
+}
+
+bool SnapshotCodec::decode(ByteReader& in, const SnapshotHistory& history,
+                           WorldSnapshot& out) {
+  out.tick = in.readU32();
+  std::uint32_t baselineTick = in.readU32();
+  if (!in.ok()) {
+    return false;
+  }
+
+  static const WorldSnapshot empty;
+  const WorldSnapshot* baseline = &empty;
+  if (baselineTick != 0) {
+    baseline = history.find(baselineTick);
+    if (!baseline) {
+      return false;
+    }
+  }
+
+  // Counts come off the wire: each removed id takes at least one byte and
+  // each changed record at least two, so anything larger than what is left
+  // is a malformed packet rather than a reason to reserve gigabytes.
+  std::uint32_t removedCount = in.readVarUInt();
+  if (!in.ok() || removedCount > in.remaining()) {
+    return false;
+  }
+  std::vector<std::uint32_t> removed;
+  removed.reserve(removedCount);
+  std::uint32_t id = 0;
+  for (std::uint32_t k = 0; k < removedCount && in.ok(); k++) {
+    if (!nextId(in, k == 0, id)) {
+      return false;
+    }
+    removed.push_back(id);
+  }
+
+  // Changed records arrive sorted by id; merge them over the baseline.
+  std::uint32_t changedCount = in.readVarUInt();
+  if (!in.ok() || changedCount > in.remaining() / 2) {
+    return false;
+  }
+  out.entities.clear();
+  out.entities.reserve(baseline->entities.size() + changedCount);
+
+  size_t baseIndex = 0;
+  size_t removedIndex = 0;
+  auto copyBaseUpTo = [&](std::uint64_t limitId) {
+    while (baseIndex < baseline->entities.size() &&
+           baseline->entities[baseIndex].id < limitId) {
+      const NetEntity& entity = baseline->entities[baseIndex++];
+      while (removedIndex < removed.size() && removed[removedIndex] < entity.id) {
+        removedIndex++;
+      }
+      if (removedIndex < removed.size() && removed[removedIndex] == entity.id) {
+        continue;
+      }
+      out.entities.push_back(entity);
+    }
+  };
+
+  id = 0;
+  for (std::uint32_t k = 0; k < changedCount && in.ok(); k++) {
+    if (!nextId(in, k == 0, id)) {
+      return false;
+    }
+    std::uint8_t mask = in.readU8();
+    copyBaseUpTo(id);
+
+    NetEntity entity = kZeroEntity;
+    if (mask & FieldNew) {
+      // An id recycled within one delta replaces the baseline entity.
+      if (baseIndex < baseline->entities.size() &&
+          baseline->entities[baseIndex].id == id) {
+        baseIndex++;
+      }
+    } else {
+      if (baseIndex >= baseline->entities.size() ||
+          baseline->entities[baseIndex].id != id) {
+        return false;
+      }
+      entity = baseline->entities[baseIndex++];
+    }
+    entity.id = id;
+    if (mask & FieldNew) entity.type = in.readU8();
+    if (mask & FieldX) entity.x += in.readVarInt();
+    if (mask & FieldY) entity.y += in.readVarInt();
+    if (mask & FieldRotation) entity.rotation = in.readU8();
+    if (mask & FieldHealth) entity.health = in.readU8();
+    out.entities.push_back(entity);
+  }
+  copyBaseUpTo(std::uint64_t(1) << 32);
+
+  return in.ok();
+}
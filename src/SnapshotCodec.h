@@ -0,0 +1,38 @@
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+#include <cstdint>
+#include <vector>
+
+#include "NetProtocol.h"
+
+// Full world state for one server tick, entities sorted by id.
+struct WorldSnapshot {
+  std::uint32_t tick = 0;
+  std::vector<NetEntity> entities;
+};
+
+// Fixed-size ring of snapshots indexed by tick, used as delta baselines.
+class SnapshotHistory {
+ private:
+  std::vector<WorldSnapshot> slots;
+
+ public:
+  SnapshotHistory();
+  void store(const WorldSnapshot& snapshot);
+  const WorldSnapshot* find(std::uint32_t tick) const;
+};
+
+class SnapshotCodec {
+ public:
+  // Encode `current` as a delta against `baseline` (nullptr = full snapshot).
+  // Returns the number of entity records written.
+  static std::size_t encode(const WorldSnapshot& current,
+                            const WorldSnapshot* baseline, ByteWriter& out);
+
+  // Decode a snapshot body previously produced by encode(). The baseline
+  // tick is read from the stream and looked up in `history`.
+  static bool decode(ByteReader& in, const SnapshotHistory& history,
+                     WorldSnapshot& out);
+};
+
+#endif  // SNAPSHOTCODEC_H
@@ -0,0 +1,116 @@
+#include "SoakTest.h"
+
+#include <cmath>
+
+#include "AllocTracker.h"
+#include "Enemy.h"
+
+namespace {
+constexpr float kSampleInterval = 5.0f;
+// Ignore the ramp-up while the enemy population reaches steady state.
+constexpr float kWarmupFraction = 0.1f;
+// Allowed growth per category over the whole run, in objects. Absolute and
+// small, so a slow leak in a category with a large live population still
+// shows up.
+constexpr double kAllowedGrowth = 4.0;
+}  // namespace
+
+SoakTest::SoakTest(float durationSeconds, std::uint32_t seed)
+    : duration(durationSeconds),
+      elapsed(0.0f),
+      sampleTimer(0.0f),
+      turnTimer(0.0f),
+      strafeAngle(0.0f),
+      randomEngine(seed) {}
+
+PlayerInput SoakTest::nextInput(const Player& player,
+                                const std::vector<Enemy*>& enemies) {
+  PlayerInput input;
+
+  // Strafe in a direction that changes every couple of seconds.
+  if (turnTimer <= 0.0f) {
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
+    std::uniform_real_distribution<float> timeDist(1.0f, 3.0f);
+    strafeAngle = angleDist(randomEngine);
+    turnTimer = timeDist(randomEngine);
+  }
+  input.move = {std::cos(strafeAngle), std::sin(strafeAngle)};
+
+  // Aim at the nearest enemy and keep the trigger held.
+  sf::Vector2f playerPos = player.getPos();
+  input.aimTarget = playerPos + sf::Vector2f(0.f, -1.f);
+  float nearestSq = -1.0f;
+  for (const Enemy* enemy : enemies) {
+    sf::Vector2f offset = enemy->getPosition() - playerPos;
+    float distSq = offset.x * offset.x + offset.y * offset.y;
+    if (nearestSq < 0.0f || distSq < nearestSq) {
+      nearestSq = distSq;
+      input.aimTarget = enemy->getPosition();
+    }
+  }
+  input.fire = true;
+  return input;
+}
+
+void SoakTest::advance(float dt) {
+  elapsed += dt;
+  turnTimer -= dt;
+  sampleTimer += dt;
+  if (sampleTimer >= kSampleInterval) {
+    Sample sample = {elapsed, {}, AllocTracker::getTotalLiveBytes()};
+    for (size_t c = 0; c < CATEGORY_COUNT; c++) {
+      sample.liveCounts[c] = AllocTracker::getLiveCount(static_cast<AllocCategory>(c));
+    }
+    samples.push_back(sample);
+    sampleTimer = 0.0f;
+  }
+}
+
+bool SoakTest::isFinished() const { return elapsed >= duration; }
+
+bool SoakTest::evaluate(std::ostream& log) const {
+  size_t first = static_cast<size_t>(samples.size() * kWarmupFraction);
+  if (samples.size() - first < 3) {
+    log << "[soak] not enough samples (" << samples.size() << ")" << std::endl;
+    return false;
+  }
+
+  // Least-squares slope of each category's live objects over time after
+  // warm-up, projected over the measured span.
+  double n = static_cast<double>(samples.size() - first);
+  double span = samples.back().time - samples[first].time;
+  size_t worst = 0;
+  double worstGrowth = 0.0;
+  double worstMean = 0.0;
+  bool passed = true;
+  for (size_t c = 0; c < CATEGORY_COUNT; c++) {
+    double sumT = 0.0, sumC = 0.0, sumTT = 0.0, sumTC = 0.0;
+    for (size_t i = first; i < samples.size(); i++) {
+      double t = samples[i].time;
+      double count = static_cast<double>(samples[i].liveCounts[c]);
+      sumT += t;
+      sumC += count;
+      sumTT += t * t;
+      sumTC += t * count;
+    }
+    double denominator = n * sumTT - sumT * sumT;
+    double slope = denominator != 0.0 ? (n * sumTC - sumT * sumC) / denominator : 0.0;
+    double projectedGrowth = slope * span;
+    if (projectedGrowth > kAllowedGrowth) {
+      passed = false;
+    }
+    if (c == 0 || projectedGrowth > worstGrowth) {
+      worst = c;
+      worstGrowth = projectedGrowth;
+      worstMean = sumC / n;
+    }
+  }
+
+  log << "[soak] " << (passed ? "PASS" : "FAIL") << ": " << samples.size()
+      << " samples over " << elapsed << " s, worst category "
+      << AllocTracker::categoryName(static_cast<AllocCategory>(worst))
+      << " (mean live " << worstMean << ", growth " << worstGrowth
+      << " objects, allowed " << kAllowedGrowth << "), final live bytes "
+      << samples.back().liveBytes << std::endl;
+  return passed;
+}
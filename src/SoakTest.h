@@ -0,0 +1,47 @@
+#ifndef SOAKTEST_H
+#define SOAKTEST_H
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "AllocTracker.h"
+#include "Player.h"
+
+class Enemy;
+
+// Replays deterministic scripted play at a fixed timestep and watches the
+// AllocTracker live counts of every category for sustained growth.
+class SoakTest {
+ private:
+  static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(AllocCategory::Count);
+
+  struct Sample {
+    float time;
+    std::array<std::int64_t, CATEGORY_COUNT> liveCounts;
+    std::int64_t liveBytes;
+  };
+
+  float duration;
+  float elapsed;
+  float sampleTimer;
+  float turnTimer;
+  float strafeAngle;
+  std::mt19937 randomEngine;
+  std::vector<Sample> samples;
+
+ public:
+  static constexpr float FIXED_DT = 1.0f / 60.0f;
+
+  SoakTest(float durationSeconds, std::uint32_t seed);
+
+  PlayerInput nextInput(const Player& player, const std::vector<Enemy*>& enemies);
+  void advance(float dt);
+  bool isFinished() const;
+
+  // Returns true when every category's live count stayed flat over the run.
+  bool evaluate(std::ostream& log) const;
+};
+
+#endif  // SOAKTEST_H
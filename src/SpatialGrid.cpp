@@ -0,0 +1,131 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize), mask(0), points(nullptr), maxOccupancy(0) {}
+
+std::int32_t SpatialGrid::coord(float value) const {
+  return static_cast<std::int32_t>(std::floor(value / cellSize));
+}
+
+size_t SpatialGrid::cellFor(std::int32_t cx, std::int32_t cy) const {
+  std::uint32_t h = static_cast<std::uint32_t>(cx) * 73856093u ^
+                    static_cast<std::uint32_t>(cy) * 19349663u;
+  return h & mask;
+}
+
+void SpatialGrid::build(const std::vector<sf::Vector2f>& newPoints) {
+  points = &newPoints;
+
+  // Power-of-two table with at least two buckets per point.
+  size_t tableSize = 16;
+  while (tableSize < newPoints.size() * 2) {
+    tableSize *= 2;
+  }
+  mask = tableSize - 1;
+
+  cellStart.assign(tableSize + 1, 0);
+  pointCell.resize(newPoints.size());
+  pointKey.resize(newPoints.size());
+  for (size_t i = 0; i < newPoints.size(); i++) {
+    std::int32_t cx = coord(newPoints[i].x);
+    std::int32_t cy = coord(newPoints[i].y);
+    size_t cell = cellFor(cx, cy);
+    pointCell[i] = static_cast<std::uint32_t>(cell);
+    pointKey[i] = std::uint64_t{static_cast<std::uint32_t>(cx)} << 32 |
+                  static_cast<std::uint32_t>(cy);
+    cellStart[cell + 1]++;
+  }
+
+  for (size_t cell = 0; cell < tableSize; cell++) {
+    cellStart[cell + 1] += cellStart[cell];
+  }
+
+  // Scatter using a running cursor per cell, then restore the starts.
+  entries.resize(newPoints.size());
+  for (size_t i = 0; i < newPoints.size(); i++) {
+    entries[cellStart[pointCell[i]]++] = static_cast<std::uint32_t>(i);
+  }
+  for (size_t cell = tableSize; cell > 0; cell--) {
+    cellStart[cell] = cellStart[cell - 1];
+  }
+  cellStart[0] = 0;
+
+  // A bucket can hold several colliding cells. Ordering each bucket by cell
+  // lets the occupancy count real cells; queries don't care about order.
+  maxOccupancy = 0;
+  for (size_t cell = 0; cell < tableSize; cell++) {
+    auto begin = entries.begin() + cellStart[cell];
+    auto end = entries.begin() + cellStart[cell + 1];
+    if (end - begin > 1) {
+      std::sort(begin, end, [this](std::uint32_t a, std::uint32_t b) {
+        return pointKey[a] < pointKey[b];
+      });
+    }
+    for (auto run = begin; run != end;) {
+      auto runEnd = run + 1;
+      while (runEnd != end && pointKey[*runEnd] == pointKey[*run]) {
+        runEnd++;
+      }
+      maxOccupancy = std::max<size_t>(maxOccupancy, static_cast<size_t>(runEnd - run));
+      run = runEnd;
+    }
+  }
+}
+
+size_t SpatialGrid::query(sf::Vector2f center, float radius, std::uint32_t exclude,
+                          size_t maxResults, std::uint32_t* out) const {
+  if (!points || points->empty() || maxResults == 0) {
+    return 0;
+  }
+
+  static const int offsets[9][2] = {{0, 0},  {1, 0},  {-1, 0}, {0, 1},  {0, -1},
+                                    {1, 1},  {-1, 1}, {1, -1}, {-1, -1}};
+  std::int32_t cx = coord(center.x);
+  std::int32_t cy = coord(center.y);
+  float radiusSq = radius * radius;
+
+  size_t visited[9];
+  size_t found = 0;
+  for (int n = 0; n < 9; n++) {
+    size_t cell = cellFor(cx + offsets[n][0], cy + offsets[n][1]);
+    // Two neighbouring cells can hash to the same bucket; scan it once.
+    if (std::find(visited, visited + n, cell) != visited + n) {
+      visited[n] = cell;
+      continue;
+    }
+    visited[n] = cell;
+
+    for (std::uint32_t e = cellStart[cell]; e < cellStart[cell + 1]; e++) {
+      std::uint32_t index = entries[e];
+      if (index == exclude) continue;
+      float distSq = distanceSq(index, center);
+      if (distSq > radiusSq) continue;
+
+      // Keep `out` sorted by distance; once full, a closer point evicts the
+      // farthest. maxResults is small, so insertion beats a heap.
+      if (found == maxResults) {
+        if (distSq >= distanceSq(out[found - 1], center)) continue;
+        found--;
+      }
+      size_t slot = found++;
+      while (slot > 0 && distanceSq(out[slot - 1], center) > distSq) {
+        out[slot] = out[slot - 1];
+        slot--;
+      }
+      out[slot] = index;
+    }
+  }
+  return found;
+}
+
+float SpatialGrid::distanceSq(std::uint32_t index, sf::Vector2f center) const {
+  sf::Vector2f offset = (*points)[index] - center;
+  return offset.x * offset.x + offset.y * offset.y;
+}
+
+float SpatialGrid::getCellSize() const { return cellSize; }
+
+size_t SpatialGrid::getMaxOccupancy() const { return maxOccupancy; }
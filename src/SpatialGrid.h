@@ -0,0 +1,45 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hashed uniform grid over a set of points, rebuilt from scratch each tick
+// with a counting sort: items end up contiguous per cell, so a radius query
+// walks a few short runs instead of testing every pair. The world is
+// unbounded, so cells are hashed into a table sized to the point count;
+// hash collisions only cost a few extra distance tests.
+class SpatialGrid {
+  float cellSize;
+  size_t mask;
+  std::vector<std::uint32_t> cellStart;  // mask + 2 entries
+  std::vector<std::uint32_t> entries;    // point indices grouped by cell
+  std::vector<std::uint32_t> pointCell;
+  std::vector<std::uint64_t> pointKey;   // packed cell coordinates per point
+  const std::vector<sf::Vector2f>* points;
+  size_t maxOccupancy;
+
+  size_t cellFor(std::int32_t cx, std::int32_t cy) const;
+  std::int32_t coord(float value) const;
+  float distanceSq(std::uint32_t index, sf::Vector2f center) const;
+
+ public:
+  explicit SpatialGrid(float cellSize);
+
+  // `points` must stay alive and unchanged until the next build().
+  void build(const std::vector<sf::Vector2f>& points);
+
+  // Writes the (up to) `maxResults` nearest points within `radius` of
+  // `center`, other than `exclude`, to `out` in order of distance and
+  // returns how many were written. `radius` should not exceed the cell size.
+  size_t query(sf::Vector2f center, float radius, std::uint32_t exclude,
+               size_t maxResults, std::uint32_t* out) const;
+
+  float getCellSize() const;
+  // Most points sharing one grid cell in the last build. Cells that collide
+  // in the hash table are still counted separately.
+  size_t getMaxOccupancy() const;
+};
+
+#endif  // SPATIALGRID_H
@@ -0,0 +1,135 @@
+#include "Starfield.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "chunk.h"
+
+const StarLayer StarfieldCache::LAYERS[StarfieldCache::LAYER_COUNT] = {
+    {0.2f, 300, 0.4f, 0.8f, 110},
+    {0.5f, 150, 0.6f, 1.2f, 170},
+    {0.8f, 60, 1.0f, 1.8f, 240},
+};
+
+StarfieldCache::StarfieldCache(size_t budgetBytes)
+    : budgetBytes(budgetBytes),
+      frame(0),
+      usedBytes(0),
+      entryCount(0),
+      bakes(0),
+      evictions(0) {}
+
+std::uint64_t StarfieldCache::makeKey(int layer, sf::Vector2i coord) {
+  return (static_cast<std::uint64_t>(layer) << 56) ^
+         (static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.x) & 0x0fffffff) << 28) ^
+         static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.y) & 0x0fffffff);
+}
+
+StarfieldCache::Entry& StarfieldCache::bake(int layer, sf::Vector2i coord) {
+  const StarLayer& config = LAYERS[layer];
+
+  // Seed from the tile so the same stars come back after eviction.
+  std::seed_seq seed{layer, coord.x, coord.y};
+  std::mt19937 randomEngine(seed);
+  std::uniform_real_distribution<float> posDist(0.0f, static_cast<float>(CHUNK_SIZE));
+  std::uniform_real_distribution<float> sizeDist(config.minSize, config.maxSize);
+  std::uniform_int_distribution<int> tintDist(-30, 15);
+
+  sf::VertexArray vertices(sf::PrimitiveType::Triangles, config.starsPerChunk * 6);
+  for (int i = 0; i < config.starsPerChunk; i++) {
+    sf::Vector2f p(posDist(randomEngine), posDist(randomEngine));
+    float s = sizeDist(randomEngine);
+    int tint = tintDist(randomEngine);
+    sf::Color color(
+        static_cast<std::uint8_t>(std::clamp(config.brightness + tint, 0, 255)),
+        static_cast<std::uint8_t>(std::clamp(config.brightness + tint / 2, 0, 255)),
+        config.brightness);
+
+    sf::Vector2f corners[4] = {p, {p.x + s, p.y}, {p.x, p.y + s}, {p.x + s, p.y + s}};
+    const int order[6] = {0, 1, 2, 1, 3, 2};
+    for (int v = 0; v < 6; v++) {
+      vertices[i * 6 + v].position = corners[order[v]];
+      vertices[i * 6 + v].color = color;
+    }
+  }
+
+  Entry& entry = entries[makeKey(layer, coord)];
+  entry.bytes = vertices.getVertexCount() * sizeof(sf::Vertex);
+  if (sf::VertexBuffer::isAvailable()) {
+    entry.buffer.emplace(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static);
+    if (entry.buffer->create(vertices.getVertexCount()) &&
+        entry.buffer->update(&vertices[0])) {
+      vertices.clear();
+    } else {
+      entry.buffer.reset();
+    }
+  }
+  if (!entry.buffer) {
+    entry.vertices = vertices;
+  }
+
+  usedBytes += entry.bytes;
+  entryCount = entries.size();
+  bakes++;
+  return entry;
+}
+
+size_t StarfieldCache::draw(sf::RenderTarget& target,
+                            const std::vector<StarfieldChunk>& chunks,
+                            const sf::RenderStates& states) {
+  frame++;
+  size_t drawCalls = 0;
+
+  for (const StarfieldChunk& chunk : chunks) {
+    auto it = entries.find(makeKey(chunk.layer, chunk.coord));
+    Entry& entry = it != entries.end() ? it->second : bake(chunk.layer, chunk.coord);
+    entry.lastUsedFrame = frame;
+
+    sf::RenderStates tileStates = states;
+    tileStates.transform.translate(
+        {chunk.coord.x * static_cast<float>(CHUNK_SIZE) + chunk.offset.x,
+         chunk.coord.y * static_cast<float>(CHUNK_SIZE) + chunk.offset.y});
+    if (entry.buffer) {
+      target.draw(*entry.buffer, tileStates);
+    } else {
+      target.draw(entry.vertices, tileStates);
+    }
+    drawCalls++;
+  }
+
+  evict();
+  return drawCalls;
+}
+
+void StarfieldCache::evict() {
+  while (usedBytes > budgetBytes) {
+    // Only tiles not drawn this frame (i.e. unloaded by the ChunkManager)
+    // are candidates; the oldest goes first.
+    auto victim = entries.end();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->second.lastUsedFrame == frame) continue;
+      if (victim == entries.end() ||
+          it->second.lastUsedFrame < victim->second.lastUsedFrame) {
+        victim = it;
+      }
+    }
+    if (victim == entries.end()) {
+      return;
+    }
+    usedBytes -= victim->second.bytes;
+    entries.erase(victim);
+    evictions++;
+  }
+  entryCount = entries.size();
+}
+
+std::string StarfieldCache::describe() const {
+  char buffer[128];
+  std::snprintf(buffer, sizeof(buffer),
+                "Starfield %zu tiles  %.1f / %.1f KB  bakes %llu  evictions %llu",
+                static_cast<size_t>(entryCount), usedBytes / 1024.0,
+                budgetBytes / 1024.0, static_cast<unsigned long long>(bakes),
+                static_cast<unsigned long long>(evictions));
+  return buffer;
+}
@@ -0,0 +1,66 @@
+#ifndef STARFIELD_H
+#define STARFIELD_H
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct StarLayer {
+  float parallax;     // 0 = fixed to the screen, 1 = moves with the world
+  int starsPerChunk;
+  float minSize;
+  float maxSize;
+  std::uint8_t brightness;
+};
+
+// One baked layer tile to draw this frame, as recorded by ChunkManager.
+struct StarfieldChunk {
+  int layer;
+  sf::Vector2i coord;   // chunk coordinate in the layer's parallax space
+  sf::Vector2f offset;  // world translation for this frame's parallax
+};
+
+// Per-chunk star geometry baked once into static vertex buffers. Lives on
+// the rendering side: only draw() touches GL resources. Tiles that the
+// ChunkManager stops requesting (unloaded chunks) are evicted least
+// recently used first once the cache exceeds its memory budget.
+class StarfieldCache {
+ public:
+  static constexpr int LAYER_COUNT = 3;
+  static const StarLayer LAYERS[LAYER_COUNT];
+
+ private:
+  struct Entry {
+    std::optional<sf::VertexBuffer> buffer;
+    sf::VertexArray vertices;  // fallback when vertex buffers are unsupported
+    size_t bytes = 0;
+    unsigned long lastUsedFrame = 0;
+  };
+
+  std::unordered_map<std::uint64_t, Entry> entries;
+  size_t budgetBytes;
+  unsigned long frame;
+  std::atomic<size_t> usedBytes;
+  std::atomic<size_t> entryCount;
+  std::atomic<std::uint64_t> bakes;
+  std::atomic<std::uint64_t> evictions;
+
+  static std::uint64_t makeKey(int layer, sf::Vector2i coord);
+  Entry& bake(int layer, sf::Vector2i coord);
+  void evict();
+
+ public:
+  explicit StarfieldCache(size_t budgetBytes = 4 * 1024 * 1024);
+
+  // Draws the requested tiles, baking any that are missing. Returns the
+  // number of draw calls (one per tile).
+  size_t draw(sf::RenderTarget& target, const std::vector<StarfieldChunk>& chunks,
+              const sf::RenderStates& states);
+
+  std::string describe() const;
+};
+
+#endif  // STARFIELD_H
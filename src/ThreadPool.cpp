@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t workerCount)
+    : job(nullptr),
+      jobCount(0),
+      rangeSize(0),
+      rangeCount(0),
+      nextRange(0),
+      busyWorkers(0),
+      generation(0),
+      stopping(false) {
+  for (size_t i = 0; i < workerCount; i++) {
+    workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::defaultWorkerCount() {
+  unsigned int cores = std::thread::hardware_concurrency();
+  return cores > 1 ? cores - 1 : 0;
+}
+
+size_t ThreadPool::rangesFor(size_t count, size_t minRangeSize) const {
+  if (count == 0) {
+    return 0;
+  }
+  minRangeSize = std::max<size_t>(minRangeSize, 1);
+  size_t maxRanges = (count + minRangeSize - 1) / minRangeSize;
+  return std::min(getThreadCount(), maxRanges);
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minRangeSize, const RangeFn& fn) {
+  size_t ranges = rangesFor(count, minRangeSize);
+  if (ranges <= 1) {
+    if (count > 0) {
+      fn(0, count, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobCount = count;
+    rangeCount = ranges;
+    rangeSize = (count + ranges - 1) / ranges;
+    nextRange = 0;
+    busyWorkers = workers.size();
+    generation++;
+  }
+  wake.notify_all();
+
+  runRanges();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [this]() { return busyWorkers == 0; });
+  job = nullptr;
+}
+
+void ThreadPool::runRanges() {
+  for (;;) {
+    size_t range = nextRange.fetch_add(1);
+    if (range >= rangeCount) {
+      return;
+    }
+    size_t begin = range * rangeSize;
+    size_t end = std::min(begin + rangeSize, jobCount);
+    if (begin < end) {
+      (*job)(begin, end, range);
+    }
+  }
+}
+
+void ThreadPool::workerLoop() {
+  unsigned long seenGeneration = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+      if (stopping) {
+        return;
+      }
+      seenGeneration = generation;
+    }
+
+    runRanges();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      busyWorkers--;
+    }
+    done.notify_one();
+  }
+}
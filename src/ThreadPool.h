@@ -0,0 +1,52 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. The calling thread
+// takes part in every parallelFor, so a pool of N workers uses N + 1 cores.
+class ThreadPool {
+ public:
+  // fn(begin, end, rangeIndex); ranges are contiguous and ordered, so
+  // per-range outputs can be merged deterministically by rangeIndex.
+  using RangeFn = std::function<void(size_t, size_t, size_t)>;
+
+ private:
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const RangeFn* job;
+  size_t jobCount;
+  size_t rangeSize;
+  size_t rangeCount;
+  std::atomic<size_t> nextRange;
+  size_t busyWorkers;
+  unsigned long generation;
+  bool stopping;
+
+  void workerLoop();
+  void runRanges();
+
+ public:
+  explicit ThreadPool(size_t workerCount = defaultWorkerCount());
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Number of ranges parallelFor will split `count` items into.
+  size_t rangesFor(size_t count, size_t minRangeSize) const;
+  // Split [0, count) into rangesFor(count, minRangeSize) ranges and run them
+  // across the pool. Blocks until every range has finished.
+  void parallelFor(size_t count, size_t minRangeSize, const RangeFn& fn);
+
+  size_t getThreadCount() const { return workers.size() + 1; }
+  static size_t defaultWorkerCount();
+};
+
+#endif  // THREADPOOL_H
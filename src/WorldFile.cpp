@@ -0,0 +1,165 @@
+#include "WorldFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+WorldFile::WorldFile(const std::string& path)
+    : data(nullptr),
+      size(0),
+#ifdef _WIN32
+      fileHandle(INVALID_HANDLE_VALUE),
+      mappingHandle(nullptr),
+#endif
+      header(nullptr),
+      index(nullptr),
+      entities(nullptr) {
+#ifdef _WIN32
+  fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open world file " + path);
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+    unmap();
+    throw std::runtime_error("Cannot size world file " + path);
+  }
+  size = static_cast<std::size_t>(fileSize.QuadPart);
+  mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mappingHandle) {
+    data = static_cast<const unsigned char*>(
+        MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open world file " + path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("Cannot size world file " + path);
+  }
+  size = static_cast<std::size_t>(info.st_size);
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // the mapping keeps its own reference
+  if (mapping != MAP_FAILED) {
+    data = static_cast<const unsigned char*>(mapping);
+    // Chunks are visited by position, not file order; skip read-ahead.
+    madvise(mapping, size, MADV_RANDOM);
+  }
+#endif
+  if (!data) {
+    unmap();
+    throw std::runtime_error("Cannot map world file " + path);
+  }
+
+  auto invalid = [&](const std::string& what) {
+    unmap();
+    return std::runtime_error("Invalid world file " + path + ": " + what);
+  };
+
+  if (size < sizeof(WorldFileHeader)) {
+    throw invalid("truncated header");
+  }
+  header = reinterpret_cast<const WorldFileHeader*>(data);
+  if (std::memcmp(header->magic, WORLD_MAGIC, sizeof(WORLD_MAGIC)) != 0) {
+    throw invalid("bad magic");
+  }
+  if (header->byteOrderMark != WORLD_BYTE_ORDER_MARK) {
+    throw invalid("packed on a machine with a different byte order");
+  }
+  if (header->version != WORLD_VERSION) {
+    throw invalid("version " + std::to_string(header->version) + ", expected " +
+                  std::to_string(WORLD_VERSION));
+  }
+  if (header->chunkSize != WORLD_CHUNK_SIZE) {
+    throw invalid("packed for chunk size " + std::to_string(header->chunkSize) +
+                  ", expected " + std::to_string(WORLD_CHUNK_SIZE));
+  }
+
+  std::uint64_t indexEnd = header->indexOffset +
+                           std::uint64_t{header->chunkCount} * sizeof(WorldChunkRecord);
+  std::uint64_t entityEnd = header->entityOffset +
+                            std::uint64_t{header->entityCount} * sizeof(WorldEntity);
+  if (header->indexOffset % 4 != 0 || header->entityOffset % 4 != 0 ||
+      indexEnd > size || entityEnd > size) {
+    throw invalid("sections out of bounds");
+  }
+  index = reinterpret_cast<const WorldChunkRecord*>(data + header->indexOffset);
+  entities = reinterpret_cast<const WorldEntity*>(data + header->entityOffset);
+
+  // Reading the index once touches only its pages and guarantees every
+  // later span stays inside the entity section.
+  for (std::uint32_t i = 0; i < header->chunkCount; i++) {
+    const WorldChunkRecord& record = index[i];
+    if (std::uint64_t{record.firstEntity} + record.entityCount > header->entityCount) {
+      throw invalid("chunk entity range out of bounds");
+    }
+    if (i > 0 && !(index[i - 1].x < record.x ||
+                   (index[i - 1].x == record.x && index[i - 1].y < record.y))) {
+      throw invalid("chunk index not sorted");
+    }
+  }
+}
+
+WorldFile::~WorldFile() { unmap(); }
+
+void WorldFile::unmap() {
+#ifdef _WIN32
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+  if (mappingHandle) {
+    CloseHandle(mappingHandle);
+  }
+  if (fileHandle != INVALID_HANDLE_VALUE) {
+    CloseHandle(fileHandle);
+  }
+  mappingHandle = nullptr;
+  fileHandle = INVALID_HANDLE_VALUE;
+#else
+  if (data) {
+    munmap(const_cast<unsigned char*>(data), size);
+  }
+#endif
+  data = nullptr;
+  header = nullptr;
+  index = nullptr;
+  entities = nullptr;
+}
+
+WorldEntitySpan WorldFile::getChunk(std::int32_t x, std::int32_t y) const {
+  const WorldChunkRecord* first = index;
+  const WorldChunkRecord* last = index + header->chunkCount;
+  const WorldChunkRecord* it = std::lower_bound(
+      first, last, std::make_pair(x, y),
+      [](const WorldChunkRecord& record, const std::pair<std::int32_t, std::int32_t>& key) {
+        return record.x < key.first || (record.x == key.first && record.y < key.second);
+      });
+  if (it == last || it->x != x || it->y != y) {
+    return {};
+  }
+  return {entities + it->firstEntity, it->entityCount, it->firstEntity};
+}
+
+std::uint32_t WorldFile::getChunkSize() const { return header->chunkSize; }
+
+std::uint32_t WorldFile::getChunkCount() const { return header->chunkCount; }
+
+std::uint32_t WorldFile::getEntityCount() const { return header->entityCount; }
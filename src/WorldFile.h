@@ -0,0 +1,52 @@
+#ifndef WORLDFILE_H
+#define WORLDFILE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "WorldFormat.h"
+
+// Entities of one chunk, pointing straight into the mapping.
+struct WorldEntitySpan {
+  const WorldEntity* entities = nullptr;
+  std::uint32_t count = 0;
+  std::uint32_t firstIndex = 0;  // file-wide index of entities[0]
+
+  const WorldEntity* begin() const { return entities; }
+  const WorldEntity* end() const { return entities + count; }
+};
+
+// Read-only memory mapping of a packed world file (see WorldFormat.h).
+// Opening validates the header and bounds once; lookups afterwards are a
+// binary search over the mapped index, so only the index and the pages of
+// chunks actually visited are ever read from disk.
+class WorldFile {
+  const unsigned char* data;
+  std::size_t size;
+#ifdef _WIN32
+  void* fileHandle;
+  void* mappingHandle;
+#endif
+  const WorldFileHeader* header;
+  const WorldChunkRecord* index;
+  const WorldEntity* entities;
+
+  void unmap();
+
+ public:
+  // Throws std::runtime_error when the file can't be mapped or is invalid.
+  explicit WorldFile(const std::string& path);
+  ~WorldFile();
+
+  WorldFile(const WorldFile&) = delete;
+  WorldFile& operator=(const WorldFile&) = delete;
+
+  // Empty span for chunks the file doesn't mention.
+  WorldEntitySpan getChunk(std::int32_t x, std::int32_t y) const;
+
+  std::uint32_t getChunkSize() const;
+  std::uint32_t getChunkCount() const;
+  std::uint32_t getEntityCount() const;
+};
+
+#endif  // WORLDFILE_H
@@ -0,0 +1,60 @@
+#ifndef WORLDFORMAT_H
+#define WORLDFORMAT_H
+#include <cstdint>
+
+// On-disk layout of world.bin, shared by the game and the worldpack tool.
+// Everything is little-endian and 4-byte aligned so the game can use the
+// records in place from a read-only memory mapping:
+//
+//   WorldFileHeader
+//   WorldChunkRecord[chunkCount]   sorted by (x, y)
+//   WorldEntity[entityCount]       grouped by chunk, in index order
+
+constexpr char WORLD_MAGIC[4] = {'S', 'S', 'W', 'D'};
+constexpr std::uint32_t WORLD_VERSION = 1;
+constexpr std::uint32_t WORLD_BYTE_ORDER_MARK = 0x01020304;
+// Chunk edge in world units; must match CHUNK_SIZE in chunk.h.
+constexpr std::uint32_t WORLD_CHUNK_SIZE = 600;
+// Spawner variants index the enemy sprites 0..WORLD_SPRITE_COUNT-1.
+constexpr int WORLD_SPRITE_COUNT = 3;
+
+enum class WorldEntityType : std::uint8_t {
+  Hazard,   // damages the player by `value` per second inside `radius`
+  Spawner,  // spawns an enemy of sprite `variant` every `value` seconds
+  Pickup,   // restores `value` health once when touched
+  Count
+};
+
+struct WorldFileHeader {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t byteOrderMark;
+  std::uint32_t chunkSize;
+  std::uint32_t chunkCount;
+  std::uint32_t entityCount;
+  std::uint32_t indexOffset;
+  std::uint32_t entityOffset;
+};
+
+struct WorldChunkRecord {
+  std::int32_t x;
+  std::int32_t y;
+  std::uint32_t firstEntity;
+  std::uint32_t entityCount;
+};
+
+struct WorldEntity {
+  float x;  // relative to the chunk's top-left corner
+  float y;
+  float radius;
+  float value;
+  std::uint8_t type;
+  std::uint8_t variant;
+  std::uint16_t reserved;
+};
+
+static_assert(sizeof(WorldFileHeader) == 32, "world header layout changed");
+static_assert(sizeof(WorldChunkRecord) == 16, "world chunk record layout changed");
+static_assert(sizeof(WorldEntity) == 20, "world entity layout changed");
+
+#endif  // WORLDFORMAT_H
@@ -9,10 +9,55 @@ sf::Vector2i ChunkManager::worldToChunk(sf::Vector2f worldPos) {
                       static_cast<int>(std::floor(worldPos.y / chunkSize)));
 }
 
-void ChunkManager::drawChunks(sf::RenderWindow &window) {
+void ChunkManager::setLoadDistance(int distance) {
+  load_distance = distance < 0 ? 0 : distance;
+}
+
+int ChunkManager::getLoadDistance() const { return load_distance; }
+
+size_t ChunkManager::getLoadedChunkCount() const { return loadedChunks.size(); }
+
+const std::vector<Chunk> &ChunkManager::getLoadedChunks() const { return loadedChunks; }
+
+void ChunkManager::setWorldFile(const WorldFile *worldFile) {
+  world = worldFile;
+  for (auto &chunk : loadedChunks) {
+    chunk.unload();
+    chunk.load(world);
+  }
+}
+
+void ChunkManager::drawChunks(RenderList &list) {
   for (const auto &chunk : loadedChunks) {
     if (chunk.isLoaded) {
-      window.draw(chunk.backgroundSprite);
+      list.addSprite(chunk.backgroundSprite);
+    }
+  }
+}
+
+void ChunkManager::drawStarfield(RenderList &list, StarfieldCache *cache,
+                                 sf::Vector2f cameraCenter) {
+  std::vector<StarfieldChunk> &tiles = list.addStarfield(cache);
+  for (int layer = 0; layer < StarfieldCache::LAYER_COUNT; ++layer) {
+    float parallax = StarfieldCache::LAYERS[layer].parallax;
+    sf::Vector2f offset = cameraCenter * (1.0f - parallax);
+    for (const auto &tile : starfieldTiles[layer]) {
+      tiles.push_back({layer, tile, offset});
+    }
+  }
+}
+
+// A layer with parallax p scrolls at p times the world speed, so its tiles
+// are streamed around the position scaled into that layer's space.
+void ChunkManager::updateStarfieldTiles(sf::Vector2f pos) {
+  for (int layer = 0; layer < StarfieldCache::LAYER_COUNT; ++layer) {
+    sf::Vector2i center = worldToChunk(pos * StarfieldCache::LAYERS[layer].parallax);
+    std::vector<sf::Vector2i> &tiles = starfieldTiles[layer];
+    tiles.clear();
+    for (int x = -load_distance; x <= load_distance; ++x) {
+      for (int y = -load_distance; y <= load_distance; ++y) {
+        tiles.emplace_back(center.x + x, center.y + y);
+      }
     }
   }
 }
@@ -37,7 +82,7 @@ void ChunkManager::UpdateChunks(sf::Vector2f pos) {
         [&chunkPos](const Chunk &c) { return c.position == chunkPos; });
     if (it == loadedChunks.end()) {
       loadedChunks.emplace_back(chunkPos);
-      loadedChunks.back().load();
+      loadedChunks.back().load(world);
     }
   }
 
@@ -51,6 +96,8 @@ void ChunkManager::UpdateChunks(sf::Vector2f pos) {
       ++it;
     }
   }
+
+  updateStarfieldTiles(pos);
 }
 
 static sf::Texture &getSharedTexture() {
@@ -79,7 +126,7 @@ Chunk::Chunk(sf::Vector2i pos)
   backgroundSprite.setScale({1.5f, 1.5f});
 }
 
-void Chunk::load() {
+void Chunk::load(const WorldFile *world) {
   if (isLoaded) return;
 
   try {
@@ -97,6 +144,9 @@ void Chunk::load() {
     float scaleY = 600.f / textureSize.y;
     backgroundSprite.setScale({scaleX, scaleY});
 
+    // No copy: the span points into the mapped file.
+    entities = world ? world->getChunk(position.x, position.y) : WorldEntitySpan{};
+
     isLoaded = true;
 
   } catch (const std::exception &e) {
@@ -106,5 +156,6 @@ void Chunk::load() {
 
 void Chunk::unload() {
   if (!isLoaded) return;
+  entities = WorldEntitySpan{};
   isLoaded = false;
 }
@@ -1,26 +1,43 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
+
+#include "RenderList.h"
+#include "Starfield.h"
+#include "WorldFile.h"
 constexpr int CHUNK_SIZE = 600;
+static_assert(CHUNK_SIZE == WORLD_CHUNK_SIZE, "world files are packed for CHUNK_SIZE");
 
 struct Chunk {
   sf::Vector2i position;
   sf::Sprite
       backgroundSprite;  // Removed texture since we're using shared texture
   bool isLoaded = false;
+  WorldEntitySpan entities;  // authored content, points into the world file
 
   Chunk(sf::Vector2i pos);
-  void load();
+  void load(const WorldFile *world);
   void unload();
 };
 
 class ChunkManager {
   std::vector<Chunk> loadedChunks;
   const int chunkSize = CHUNK_SIZE;
-  const int load_distance = 2;
+  int load_distance = 2;
+  const WorldFile *world = nullptr;
+  // Parallax star tiles kept alive per layer, streamed like the chunks
+  std::vector<sf::Vector2i> starfieldTiles[StarfieldCache::LAYER_COUNT];
+
+  void updateStarfieldTiles(sf::Vector2f pos);
 
  public:
   void UpdateChunks(sf::Vector2f pos);
-  void drawChunks(sf::RenderWindow &window);
+  void setLoadDistance(int distance);
+  int getLoadDistance() const;
+  size_t getLoadedChunkCount() const;
+  const std::vector<Chunk> &getLoadedChunks() const;
+  void setWorldFile(const WorldFile *worldFile);
+  void drawChunks(RenderList &list);
+  void drawStarfield(RenderList &list, StarfieldCache *cache, sf::Vector2f cameraCenter);
   sf::Vector2i worldToChunk(sf::Vector2f pos);
 };
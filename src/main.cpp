@@ -1,11 +1,176 @@
+#include "Benchmarks.h"
 #include "Game.h"
+#include "LoopbackServer.h"
+#include "NetViewer.h"
+#include "ScriptedClient.h"
+#include <SFML/System.hpp>
+#include <cstdlib>
 #include <iostream>
 #include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
-int main() {
+namespace {
+struct NetOptions {
+  bool server = false;
+  bool connect = false;
+  int bots = 0;
+  int loopbackClients = 0;
+  unsigned short port = DEFAULT_SERVER_PORT;
+  int tickRate = DEFAULT_TICK_RATE;
+  float duration = 0.0f;
+};
+
+NetOptions parseNetOptions(int argc, char* argv[]) {
+  NetOptions options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--server") {
+      options.server = true;
+    } else if (arg == "--connect") {
+      options.connect = true;
+    } else if (arg == "--bots" && hasValue) {
+      options.bots = std::atoi(argv[++i]);
+    } else if (arg == "--loopback" && hasValue) {
+      options.loopbackClients = std::atoi(argv[++i]);
+    } else if (arg == "--port" && hasValue) {
+      options.port = static_cast<unsigned short>(std::atoi(argv[++i]));
+    } else if (arg == "--tick-rate" && hasValue) {
+      options.tickRate = std::atoi(argv[++i]);
+    } else if (arg == "--duration" && hasValue) {
+      options.duration = static_cast<float>(std::atof(argv[++i]));
+    }
+  }
+  return options;
+}
+
+GameOptions parseGameOptions(int argc, char* argv[]) {
+  GameOptions options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--soak" && hasValue) {
+      options.soakSeconds = static_cast<float>(std::atof(argv[++i]));
+    } else if (arg == "--seed" && hasValue) {
+      options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--no-render-thread") {
+      options.renderThread = false;
+    } else if (arg == "--low-latency") {
+      options.lowLatency = true;
+    } else if (arg == "--pacing" && hasValue) {
+      std::string mode = argv[++i];
+      if (!FramePacer::parseMode(mode, options.pacing)) {
+        std::cerr << "Unknown pacing mode '" << mode
+                  << "' (unlimited, vsync, limit, idle)" << std::endl;
+      }
+    } else if (arg == "--fps" && hasValue) {
+      options.targetFps = static_cast<float>(std::atof(argv[++i]));
+    } else if (arg == "--min-scale" && hasValue) {
+      options.minRenderScale = static_cast<float>(std::atof(argv[++i]));
+    } else if (arg == "--max-scale" && hasValue) {
+      options.maxRenderScale = static_cast<float>(std::atof(argv[++i]));
+    } else if (arg == "--metrics" && hasValue) {
+      options.metricsDir = argv[++i];
+    } else if (arg == "--metrics-interval" && hasValue) {
+      options.metricsInterval = static_cast<float>(std::atof(argv[++i]));
+    } else if (arg == "--world" && hasValue) {
+      options.worldPath = argv[++i];
+    } else if (arg == "--scenario" && hasValue) {
+      options.scenarioPath = argv[++i];
+    } else if (arg == "--headless") {
+      options.headless = true;
+    }
+  }
+  return options;
+}
+
+void runBots(int count, const NetOptions& options) {
+  std::vector<std::unique_ptr<ScriptedClient>> clients;
+  for (int i = 0; i < count; i++) {
+    clients.push_back(
+        std::make_unique<ScriptedClient>(i, options.port, options.tickRate));
+  }
+
+  const float frameTime = 1.0f / 60.0f;
+  sf::Clock sessionClock;
+  sf::Clock frameClock;
+  while (options.duration <= 0.0f ||
+         sessionClock.getElapsedTime().asSeconds() < options.duration) {
+    frameClock.restart();
+    for (auto& client : clients) {
+      client->update(frameTime);
+      client->interpolate();
+    }
+    sf::Time elapsed = frameClock.getElapsedTime();
+    if (elapsed < sf::seconds(frameTime)) {
+      sf::sleep(sf::seconds(frameTime) - elapsed);
+    }
+  }
+
+  float seconds = sessionClock.getElapsedTime().asSeconds();
+  for (auto& client : clients) {
+    client->disconnect();
+    client->printStats(seconds);
+  }
+}
+
+void runLoopback(const NetOptions& options) {
+  LoopbackServer server(options.port, options.tickRate);
+  std::thread serverThread([&server]() { server.run(); });
+
+  NetOptions botOptions = options;
+  if (botOptions.duration <= 0.0f) {
+    botOptions.duration = 30.0f;
+  }
+  runBots(options.loopbackClients, botOptions);
+
+  server.stop();
+  serverThread.join();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
   try {
-    Game game;
+    for (int i = 1; i < argc; i++) {
+      if (std::string(argv[i]) == "--bench-collisions") {
+        return runCollisionBenchmark();
+      }
+      if (std::string(argv[i]) == "--bench-bullets") {
+        return runBulletBenchmark();
+      }
+    }
+
+    NetOptions netOptions = parseNetOptions(argc, argv);
+    if (netOptions.loopbackClients > 0) {
+      runLoopback(netOptions);
+      return 0;
+    }
+    if (netOptions.server) {
+      LoopbackServer server(netOptions.port, netOptions.tickRate);
+      server.run(netOptions.duration);
+      return 0;
+    }
+    if (netOptions.connect) {
+      return runNetViewer(netOptions.port, netOptions.tickRate, netOptions.duration);
+    }
+    if (netOptions.bots > 0) {
+      runBots(netOptions.bots, netOptions);
+      return 0;
+    }
+
+    GameOptions gameOptions = parseGameOptions(argc, argv);
+    if (gameOptions.headless && gameOptions.scenarioPath.empty() &&
+        gameOptions.soakSeconds <= 0.0f) {
+      std::cerr << "--headless needs --scenario or --soak to drive the game" << std::endl;
+      return 2;
+    }
+
+    Game game(gameOptions);
     game.run();
+    return game.getExitCode();
   } catch (const std::system_error& e) {
     std::cerr << "System error: " << e.what() << std::endl;
     std::cerr << "Error code: " << e.code() << std::endl;
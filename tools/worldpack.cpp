@@ -0,0 +1,164 @@
+// worldpack: converts a readable world source into the binary world.bin
+// the game memory-maps at start-up.
+//
+//   worldpack <source.txt> <world.bin>
+//
+// Source format, one statement per line, '#' starts a comment:
+//   chunk   <cx> <cy>                      following entities belong here
+//   hazard  <x> <y> <radius> <damage/s>
+//   spawner <x> <y> <seconds> [sprite]
+//   pickup  <x> <y> <health> [radius]
+// Entity positions are relative to the chunk's top-left corner.
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "WorldFormat.h"
+
+namespace {
+bool fail(const std::string& source, int line, const std::string& message) {
+  std::cerr << source << ":" << line << ": " << message << std::endl;
+  return false;
+}
+
+bool parseSource(const std::string& path,
+                 std::map<std::pair<std::int32_t, std::int32_t>, std::vector<WorldEntity>>& chunks) {
+  std::ifstream in(path);
+  if (!in) {
+    std::cerr << "Cannot open " << path << std::endl;
+    return false;
+  }
+
+  std::vector<WorldEntity>* current = nullptr;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    lineNumber++;
+    line = line.substr(0, line.find('#'));
+    std::istringstream tokens(line);
+    std::string keyword;
+    if (!(tokens >> keyword)) {
+      continue;
+    }
+
+    if (keyword == "chunk") {
+      std::int32_t x, y;
+      if (!(tokens >> x >> y)) {
+        return fail(path, lineNumber, "expected: chunk <cx> <cy>");
+      }
+      current = &chunks[{x, y}];
+      continue;
+    }
+    if (!current) {
+      return fail(path, lineNumber, "'" + keyword + "' before any chunk");
+    }
+
+    WorldEntity entity{};
+    float extra = -1.0f;
+    if (!(tokens >> entity.x >> entity.y)) {
+      return fail(path, lineNumber, "expected a position after '" + keyword + "'");
+    }
+    if (keyword == "hazard") {
+      entity.type = static_cast<std::uint8_t>(WorldEntityType::Hazard);
+      if (!(tokens >> entity.radius >> entity.value)) {
+        return fail(path, lineNumber, "expected: hazard <x> <y> <radius> <damage/s>");
+      }
+      if (entity.radius < 0.0f) {
+        return fail(path, lineNumber, "hazard radius must not be negative");
+      }
+    } else if (keyword == "spawner") {
+      entity.type = static_cast<std::uint8_t>(WorldEntityType::Spawner);
+      entity.radius = 8.0f;
+      if (!(tokens >> entity.value) || entity.value <= 0.0f) {
+        return fail(path, lineNumber, "expected: spawner <x> <y> <seconds> [sprite]");
+      }
+      if (tokens >> extra) {
+        if (extra < 0.0f || extra >= WORLD_SPRITE_COUNT || extra != std::floor(extra)) {
+          return fail(path, lineNumber,
+                      "spawner sprite must be 0 to " + std::to_string(WORLD_SPRITE_COUNT - 1));
+        }
+        entity.variant = static_cast<std::uint8_t>(extra);
+      }
+    } else if (keyword == "pickup") {
+      entity.type = static_cast<std::uint8_t>(WorldEntityType::Pickup);
+      entity.radius = 6.0f;
+      if (!(tokens >> entity.value)) {
+        return fail(path, lineNumber, "expected: pickup <x> <y> <health> [radius]");
+      }
+      if (tokens >> extra) {
+        if (extra < 0.0f) {
+          return fail(path, lineNumber, "pickup radius must not be negative");
+        }
+        entity.radius = extra;
+      }
+    } else {
+      return fail(path, lineNumber, "unknown statement '" + keyword + "'");
+    }
+
+    std::string trailing;
+    if (tokens >> trailing) {
+      return fail(path, lineNumber, "unexpected '" + trailing + "'");
+    }
+    if (entity.x < 0.0f || entity.y < 0.0f || entity.x > WORLD_CHUNK_SIZE ||
+        entity.y > WORLD_CHUNK_SIZE) {
+      return fail(path, lineNumber, "position outside the chunk");
+    }
+    current->push_back(entity);
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cerr << "usage: worldpack <source.txt> <world.bin>" << std::endl;
+    return 2;
+  }
+
+  // std::map orders keys by (x, y), which is the order the index needs.
+  std::map<std::pair<std::int32_t, std::int32_t>, std::vector<WorldEntity>> chunks;
+  if (!parseSource(argv[1], chunks)) {
+    return 1;
+  }
+
+  std::vector<WorldChunkRecord> index;
+  std::vector<WorldEntity> entities;
+  for (const auto& [coord, chunkEntities] : chunks) {
+    index.push_back({coord.first, coord.second, static_cast<std::uint32_t>(entities.size()),
+                     static_cast<std::uint32_t>(chunkEntities.size())});
+    entities.insert(entities.end(), chunkEntities.begin(), chunkEntities.end());
+  }
+
+  WorldFileHeader header{};
+  std::memcpy(header.magic, WORLD_MAGIC, sizeof(WORLD_MAGIC));
+  header.version = WORLD_VERSION;
+  header.byteOrderMark = WORLD_BYTE_ORDER_MARK;
+  header.chunkSize = WORLD_CHUNK_SIZE;
+  header.chunkCount = static_cast<std::uint32_t>(index.size());
+  header.entityCount = static_cast<std::uint32_t>(entities.size());
+  header.indexOffset = sizeof(WorldFileHeader);
+  header.entityOffset =
+      header.indexOffset + static_cast<std::uint32_t>(index.size() * sizeof(WorldChunkRecord));
+
+  std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(index.data()),
+            static_cast<std::streamsize>(index.size() * sizeof(WorldChunkRecord)));
+  out.write(reinterpret_cast<const char*>(entities.data()),
+            static_cast<std::streamsize>(entities.size() * sizeof(WorldEntity)));
+  if (!out) {
+    std::cerr << "Failed to write " << argv[2] << std::endl;
+    return 1;
+  }
+
+  std::printf("worldpack: %zu chunks, %zu entities -> %s\n", index.size(), entities.size(),
+              argv[2]);
+  return 0;
+}